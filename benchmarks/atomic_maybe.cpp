@@ -0,0 +1,111 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "atomic_maybe.hpp"
+
+/// \cond
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+struct RoutingTable
+{
+    explicit RoutingTable(std::uint32_t version)
+        : routes(1024, version)
+    {}
+
+    std::vector<std::uint32_t> routes;
+};
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static constexpr std::size_t writer_period = 4096;
+
+static void shared_ptr_read(benchmark::State& state)
+{
+    static std::mutex mutex;
+    static std::shared_ptr<const RoutingTable> table = std::make_shared<const RoutingTable>(0);
+
+    std::size_t key = static_cast<std::size_t>(state.thread_index());
+    std::uint32_t version = 0;
+
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0 && ++key % writer_period == 0)
+        {
+            auto fresh = std::make_shared<const RoutingTable>(++version);
+            std::lock_guard<std::mutex> lock(mutex);
+            table = std::move(fresh);
+        }
+
+        std::shared_ptr<const RoutingTable> snapshot;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            snapshot = table;
+        }
+
+        benchmark::DoNotOptimize(snapshot->routes[++key % snapshot->routes.size()]);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void atomic_maybe_read(benchmark::State& state)
+{
+    static atomic_maybe_t<RoutingTable> table{RoutingTable(0)};
+
+    std::size_t key = static_cast<std::size_t>(state.thread_index());
+    std::uint32_t version = 0;
+
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0 && ++key % writer_period == 0)
+        {
+            table.emplace(++version);
+        }
+
+        table.read([&](maybe_t<const RoutingTable&> snapshot) {
+            if (snapshot.has_value())
+            {
+                benchmark::DoNotOptimize(snapshot->routes[++key % snapshot->routes.size()]);
+            }
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void packed_read(benchmark::State& state)
+{
+    static atomic_maybe_t<std::uint32_t> limit{0U};
+
+    std::size_t key = static_cast<std::size_t>(state.thread_index());
+    std::uint32_t version = 0;
+
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0 && ++key % writer_period == 0)
+        {
+            limit.store(++version);
+        }
+
+        benchmark::DoNotOptimize(limit.load());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(shared_ptr_read)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(atomic_maybe_read)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(packed_read)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,212 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "batch.hpp"
+
+/// \cond
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+using record_t = result_t<int, std::string>;
+
+static std::deque<record_t> make_records(std::size_t size, bool with_errors)
+{
+    std::deque<record_t> items;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (with_errors && i % 16 == 15)
+        {
+            items.emplace_back(fail_t<std::string>("malformed record"));
+        }
+        else
+        {
+            items.emplace_back(success_t<int>(static_cast<int>(i)));
+        }
+    }
+
+    return items;
+}
+
+static void loop_collect(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), false);
+
+    for (auto _ : state)
+    {
+        std::vector<int> values;
+        bool failed = false;
+
+        for (const auto& item : items)
+        {
+            if (!item.has_value())
+            {
+                failed = true;
+                break;
+            }
+
+            values.push_back(*item);
+        }
+
+        benchmark::DoNotOptimize(failed);
+        benchmark::DoNotOptimize(values.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void batch_collect(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), false);
+
+    for (auto _ : state)
+    {
+        auto values = collect(items);
+        benchmark::DoNotOptimize(values->data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void batch_collect_parallel(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), false);
+
+    for (auto _ : state)
+    {
+        auto values = collect(utils::par, items);
+        benchmark::DoNotOptimize(values->data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void loop_partition(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), true);
+
+    for (auto _ : state)
+    {
+        std::vector<int> values;
+        std::vector<std::string> errors;
+
+        for (const auto& item : items)
+        {
+            if (item.has_value())
+            {
+                values.push_back(*item);
+            }
+            else
+            {
+                errors.push_back(item.error());
+            }
+        }
+
+        benchmark::DoNotOptimize(values.data());
+        benchmark::DoNotOptimize(errors.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void batch_partition(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), true);
+
+    for (auto _ : state)
+    {
+        auto [values, errors] = partition(items);
+
+        benchmark::DoNotOptimize(values.data());
+        benchmark::DoNotOptimize(errors.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void batch_partition_parallel(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), true);
+
+    for (auto _ : state)
+    {
+        auto [values, errors] = partition(utils::par, items);
+
+        benchmark::DoNotOptimize(values.data());
+        benchmark::DoNotOptimize(errors.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void loop_fold(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), false);
+
+    for (auto _ : state)
+    {
+        long sum = 0;
+
+        for (const auto& item : items)
+        {
+            if (!item.has_value())
+            {
+                break;
+            }
+
+            sum += *item;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void batch_try_fold(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), false);
+    auto plus = [](long acc, int item) { return acc + item; };
+
+    for (auto _ : state)
+    {
+        auto sum = try_fold(items, 0L, plus);
+        benchmark::DoNotOptimize(*sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void batch_try_fold_parallel(benchmark::State& state)
+{
+    auto items = make_records(static_cast<std::size_t>(state.range(0)), false);
+    auto plus = [](long acc, int item) { return acc + item; };
+    auto merge = [](long lhs, long rhs) { return lhs + rhs; };
+
+    for (auto _ : state)
+    {
+        auto sum = try_fold(utils::par, items, 0L, plus, merge);
+        benchmark::DoNotOptimize(*sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(loop_collect)->Range(1 << 10, 1 << 20);
+BENCHMARK(batch_collect)->Range(1 << 10, 1 << 20);
+BENCHMARK(batch_collect_parallel)->Range(1 << 10, 1 << 20);
+BENCHMARK(loop_partition)->Range(1 << 10, 1 << 20);
+BENCHMARK(batch_partition)->Range(1 << 10, 1 << 20);
+BENCHMARK(batch_partition_parallel)->Range(1 << 10, 1 << 20);
+BENCHMARK(loop_fold)->Range(1 << 10, 1 << 20);
+BENCHMARK(batch_try_fold)->Range(1 << 10, 1 << 20);
+BENCHMARK(batch_try_fold_parallel)->Range(1 << 10, 1 << 20);
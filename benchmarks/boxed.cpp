@@ -0,0 +1,78 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "boxed.hpp"
+
+/// \cond
+#include <cstdint>
+#include <string>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+struct RichError
+{
+    std::string message;
+    std::string context;
+    const char* file;
+    int line;
+    int code;
+};
+
+using inline_result_t = result_t<std::uint64_t, RichError>;
+using boxed_result_t = cold_result_t<std::uint64_t, RichError>;
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+template <typename Result>
+[[gnu::noinline]] static Result leaf(std::uint64_t input)
+{
+    if (input == 0)
+    {
+        return emplace_fail<typename Result::error_type>(RichError{"zero input", "leaf", __FILE__, __LINE__, 22});
+    }
+
+    return success_t<std::uint64_t>(input * 3);
+}
+
+template <typename Result>
+[[gnu::noinline]] static Result layer(std::uint64_t input, int depth)
+{
+    if (depth == 0)
+    {
+        return leaf<Result>(input);
+    }
+
+    auto result = layer<Result>(input, depth - 1);
+
+    if (!result.has_value())
+    {
+        return fail_t<typename Result::error_type>(std::move(result).error());
+    }
+
+    return success_t<std::uint64_t>(*result + 1);
+}
+
+static constexpr int stack_depth = 5;
+
+template <typename Result>
+static void result_path(benchmark::State& state)
+{
+    auto input = static_cast<std::uint64_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto result = layer<Result>(input, stack_depth);
+        benchmark::DoNotOptimize(result.has_value());
+    }
+
+    state.counters["bytes"] = static_cast<double>(sizeof(Result));
+}
+
+BENCHMARK(result_path<inline_result_t>)->Name("inline_error")->Arg(1)->Arg(0);
+BENCHMARK(result_path<boxed_result_t>)->Name("boxed_error")->Arg(1)->Arg(0);
@@ -0,0 +1,97 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "channel.hpp"
+#include "socket.hpp"
+
+/// \cond
+#include <sys/wait.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+template <typename Transport>
+static bool recv_exact(const Transport& transport, std::byte* data, std::size_t length)
+{
+    while (length != 0)
+    {
+        auto received = transport.recv(data, length);
+
+        if (!received || *received == 0)
+        {
+            return false;
+        }
+
+        data += *received;
+        length -= *received;
+    }
+
+    return true;
+}
+
+// The echo side runs in a forked child, so every round trip crosses a real
+// process boundary; one-way latency is half the reported time.
+template <typename Transport>
+static void echo_ping_pong(benchmark::State& state, Transport& client, Transport& peer)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    pid_t child = ::fork();
+
+    if (child == 0)
+    {
+        // The child's copy of the client socket would hold the connection
+        // open; a channel endpoint must stay untouched since close() hangs
+        // up both directions.
+        if constexpr (std::is_same_v<Transport, socket_t>)
+        {
+            client.close();
+        }
+
+        std::vector<std::byte> buffer(size);
+
+        while (recv_exact(peer, buffer.data(), size))
+        {
+            std::ignore = peer.send(buffer.data(), size);
+        }
+
+        ::_exit(0);
+    }
+
+    std::vector<std::byte> buffer(size);
+
+    for (auto _ : state)
+    {
+        std::ignore = client.send(buffer.data(), size);
+        recv_exact(client, buffer.data(), size);
+    }
+
+    client.close();
+    peer.close();
+
+    ::waitpid(child, nullptr, 0);
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+
+static void channel_ping_pong(benchmark::State& state)
+{
+    auto channels = channel_t::pair(1 << 16);
+    echo_ping_pong(state, channels->first, channels->second);
+}
+
+static void socketpair_ping_pong(benchmark::State& state)
+{
+    auto sockets = socket_t::pair();
+    echo_ping_pong(state, sockets->first, sockets->second);
+}
+
+BENCHMARK(channel_ping_pong)->Range(8, 1 << 14)->UseRealTime();
+BENCHMARK(socketpair_ping_pong)->Range(8, 1 << 14)->UseRealTime();
@@ -0,0 +1,232 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "column.hpp"
+#include "maybe.hpp"
+
+/// \cond
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static std::vector<maybe_t<double>> make_items(std::size_t size)
+{
+    std::vector<maybe_t<double>> items;
+    items.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (i % 7 == 0)
+        {
+            items.emplace_back(utils::nothing);
+        }
+        else
+        {
+            items.emplace_back(static_cast<double>(i % 1024));
+        }
+    }
+
+    return items;
+}
+
+static void maybe_vector_count(benchmark::State& state)
+{
+    auto items = make_items(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+
+        for (const auto& item : items)
+        {
+            count += item.has_value() ? 1U : 0U;
+        }
+
+        benchmark::DoNotOptimize(count);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void column_count(benchmark::State& state)
+{
+    column_t<double> column(make_items(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(column.count());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void maybe_vector_sum(benchmark::State& state)
+{
+    auto items = make_items(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+
+        for (const auto& item : items)
+        {
+            if (item.has_value())
+            {
+                sum += *item;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void column_sum(benchmark::State& state)
+{
+    column_t<double> column(make_items(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(column.sum());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void column_sum_parallel(benchmark::State& state)
+{
+    column_t<double> column(make_items(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(column.sum(utils::par));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void maybe_vector_max(benchmark::State& state)
+{
+    auto items = make_items(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        maybe_t<double> max = utils::nothing;
+
+        for (const auto& item : items)
+        {
+            if (item.has_value() && (!max.has_value() || *item > *max))
+            {
+                max = item;
+            }
+        }
+
+        benchmark::DoNotOptimize(max);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void column_max(benchmark::State& state)
+{
+    column_t<double> column(make_items(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(column.max());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void maybe_vector_filter(benchmark::State& state)
+{
+    auto items = make_items(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::vector<double> result;
+
+        for (const auto& item : items)
+        {
+            if (item.has_value() && *item > 512.0)
+            {
+                result.push_back(*item);
+            }
+        }
+
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void column_filter(benchmark::State& state)
+{
+    column_t<double> column(make_items(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state)
+    {
+        auto result = column.filter([](double item) { return item > 512.0; });
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void maybe_vector_fill(benchmark::State& state)
+{
+    auto items = make_items(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        auto copy = items;
+
+        for (auto& item : copy)
+        {
+            if (!item.has_value())
+            {
+                item = maybe_t<double>(0.0);
+            }
+        }
+
+        benchmark::DoNotOptimize(copy.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void column_fill(benchmark::State& state)
+{
+    column_t<double> column(make_items(static_cast<std::size_t>(state.range(0))));
+
+    for (auto _ : state)
+    {
+        auto copy = column;
+        copy.fill_nothing(0.0);
+
+        benchmark::DoNotOptimize(copy.values());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(maybe_vector_count)->Range(1 << 10, 1 << 22);
+BENCHMARK(column_count)->Range(1 << 10, 1 << 22);
+BENCHMARK(maybe_vector_sum)->Range(1 << 10, 1 << 22);
+BENCHMARK(column_sum)->Range(1 << 10, 1 << 22);
+BENCHMARK(column_sum_parallel)->Range(1 << 16, 1 << 22);
+BENCHMARK(maybe_vector_max)->Range(1 << 10, 1 << 22);
+BENCHMARK(column_max)->Range(1 << 10, 1 << 22);
+BENCHMARK(maybe_vector_filter)->Range(1 << 10, 1 << 22);
+BENCHMARK(column_filter)->Range(1 << 10, 1 << 22);
+BENCHMARK(maybe_vector_fill)->Range(1 << 10, 1 << 22);
+BENCHMARK(column_fill)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,101 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "concurrent_map.hpp"
+
+/// \cond
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static constexpr std::uint64_t key_space = 1 << 16;
+
+static std::uint64_t next_random(std::uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return state;
+}
+
+class locked_map_t
+{
+public:
+    [[nodiscard]] maybe_t<std::uint64_t> find(std::uint64_t key) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        auto it = m_map.find(key);
+
+        if (it == m_map.end())
+        {
+            return utils::nothing;
+        }
+
+        return it->second;
+    }
+
+    void insert_or_assign(std::uint64_t key, std::uint64_t value)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_map.insert_or_assign(key, value);
+    }
+
+private:
+    mutable std::shared_mutex m_mutex;
+    std::unordered_map<std::uint64_t, std::uint64_t> m_map;
+};
+
+template <typename Map>
+static Map& shared_map()
+{
+    static Map* map = []() {
+        auto* instance = new Map();
+
+        for (std::uint64_t key = 0; key < key_space; ++key)
+        {
+            instance->insert_or_assign(key, key);
+        }
+
+        return instance;
+    }();
+
+    return *map;
+}
+
+template <typename Map>
+static void mixed_workload(benchmark::State& state)
+{
+    auto& map = shared_map<Map>();
+    auto read_percent = static_cast<std::uint64_t>(state.range(0));
+    std::uint64_t random = std::uint64_t{0x9e3779b97f4a7c15} + static_cast<std::uint64_t>(state.thread_index());
+
+    for (auto _ : state)
+    {
+        std::uint64_t draw = next_random(random);
+        std::uint64_t key = draw % key_space;
+
+        if ((draw >> 32) % 100 < read_percent)
+        {
+            benchmark::DoNotOptimize(map.find(key));
+        }
+        else
+        {
+            map.insert_or_assign(key, draw);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(mixed_workload<locked_map_t>)->Name("locked_unordered_map")->ArgName("read%")->Arg(100)->Arg(90)->Arg(50)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(mixed_workload<concurrent_map_t<std::uint64_t, std::uint64_t>>)->Name("concurrent_map")->ArgName("read%")->Arg(100)->Arg(90)->Arg(50)->ThreadRange(1, 16)->UseRealTime();
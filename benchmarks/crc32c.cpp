@@ -0,0 +1,88 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "crc32c.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+// The usual one-table loop, one lookup per byte.
+[[gnu::noinline]] static std::uint32_t bytewise(std::uint32_t crc, const std::byte* data, std::size_t length)
+{
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        crc = (crc >> 8) ^ crc32c::tables[0][(crc ^ static_cast<std::uint32_t>(data[i])) & 0xFF];
+    }
+
+    return crc;
+}
+
+static std::vector<std::byte> make_message(std::size_t size)
+{
+    std::vector<std::byte> message(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        message[i] = static_cast<std::byte>(i * 131 + 7);
+    }
+
+    return message;
+}
+
+template <std::uint32_t (*Kernel)(std::uint32_t, const std::byte*, std::size_t)>
+static void checksum(benchmark::State& state)
+{
+    auto message = make_message(static_cast<std::size_t>(state.range(0)));
+    std::uint32_t crc = ~std::uint32_t{0};
+
+    // Chaining the register keeps short messages from overlapping.
+    for (auto _ : state)
+    {
+        crc = Kernel(crc, message.data(), message.size());
+        benchmark::DoNotOptimize(crc);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// A frame sent as header, payload and trailer vectors, as output_buffer_t
+// hands them to sendmsg.
+static void checksum_gathered(benchmark::State& state)
+{
+    auto message = make_message(static_cast<std::size_t>(state.range(0)));
+    std::size_t payload = message.size() - 24;
+
+    std::array<iovec, 3> vectors = {
+        iovec{message.data(), 16},
+        iovec{message.data() + 16, payload},
+        iovec{message.data() + 16 + payload, 8},
+    };
+
+    crc32c_t crc;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(crc.update(std::span<const iovec>(vectors)).value());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(checksum<bytewise>)->Name("crc32c/bytewise")->RangeMultiplier(8)->Range(64, 1 << 20);
+BENCHMARK(checksum<crc32c::portable>)->Name("crc32c/slicing_by_8")->RangeMultiplier(8)->Range(64, 1 << 20);
+#if CPU_X86_DISPATCH && defined(__x86_64__)
+BENCHMARK(checksum<crc32c::sse42>)->Name("crc32c/sse42")->RangeMultiplier(8)->Range(64, 1 << 20);
+BENCHMARK(checksum<crc32c::pclmul>)->Name("crc32c/pclmul")->RangeMultiplier(8)->Range(64, 1 << 20);
+#endif  // CPU_X86_DISPATCH && __x86_64__
+BENCHMARK(checksum<crc32c::extend>)->Name("crc32c/dispatched")->RangeMultiplier(8)->Range(64, 1 << 20);
+BENCHMARK(checksum_gathered)->Name("crc32c/gathered")->RangeMultiplier(8)->Range(64, 1 << 20);
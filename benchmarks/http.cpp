@@ -0,0 +1,74 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "http.hpp"
+
+/// \cond
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static constexpr std::string_view sample_request = "GET /api/v1/metrics?window=60s&format=json HTTP/1.1\r\n"
+                                                   "Host: admin.internal.example.com:8443\r\n"
+                                                   "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0 Safari/537.36\r\n"
+                                                   "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+                                                   "Accept-Language: en-US,en;q=0.9\r\n"
+                                                   "Accept-Encoding: gzip, deflate, br\r\n"
+                                                   "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark; tracking=disabled\r\n"
+                                                   "Connection: keep-alive\r\n"
+                                                   "\r\n";
+
+static void http_parse_pipelined(benchmark::State& state)
+{
+    std::string buffer;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        buffer += sample_request;
+    }
+
+    http_parser_t parser;
+
+    for (auto _ : state)
+    {
+        std::string_view remaining = buffer;
+
+        while (!remaining.empty())
+        {
+            auto request = parser.parse(remaining);
+            benchmark::DoNotOptimize(request.has_value());
+
+            remaining.remove_prefix(request->size);
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+
+template <std::size_t (*Scan)(const char*, std::size_t)>
+static void http_scan_value(benchmark::State& state)
+{
+    std::string value(static_cast<std::size_t>(state.range(0)), 'v');
+    value.back() = '\r';
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Scan(value.data(), value.size()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(http_parse_pipelined)->Arg(1)->Arg(16)->Arg(256);
+BENCHMARK(http_scan_value<http_scan_t::scalar<true>>)->Range(16, 4096);
+#if CPU_X86_DISPATCH
+BENCHMARK(http_scan_value<http_scan_t::sse42<true>>)->Range(16, 4096);
+BENCHMARK(http_scan_value<http_scan_t::avx2<true>>)->Range(16, 4096);
+#endif  // CPU_X86_DISPATCH
@@ -0,0 +1,101 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "inplace_function.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static constexpr std::int64_t queue_length = 256;
+
+// A lambda capturing Size bytes, the way an I/O completion captures a
+// connection pointer, a buffer span and a few counters.
+template <std::size_t Size>
+static auto make_callback(std::uint64_t seed)
+{
+    std::array<std::uint64_t, Size / sizeof(std::uint64_t)> captured{};
+    captured.fill(seed);
+
+    return [captured](std::uint64_t value) {
+        return value + captured.back();
+    };
+}
+
+// Fills a queue of callbacks and drains it, as an event loop does with the
+// completions of one poll round.
+template <typename Function, std::size_t Size>
+static void enqueue_and_run(benchmark::State& state)
+{
+    std::vector<Function> queue;
+    queue.reserve(static_cast<std::size_t>(queue_length));
+
+    std::uint64_t total = 0;
+
+    for (auto _ : state)
+    {
+        for (std::int64_t i = 0; i < queue_length; ++i)
+        {
+            queue.emplace_back(make_callback<Size>(static_cast<std::uint64_t>(i)));
+        }
+
+        for (auto& callback : queue)
+        {
+            total = callback(total);
+        }
+
+        queue.clear();
+    }
+
+    benchmark::DoNotOptimize(total);
+    state.SetItemsProcessed(state.iterations() * queue_length);
+}
+
+// Calls stored callbacks only, to isolate the dispatch cost.
+template <typename Function, std::size_t Size>
+static void invoke_only(benchmark::State& state)
+{
+    std::vector<Function> queue;
+
+    for (std::int64_t i = 0; i < queue_length; ++i)
+    {
+        queue.emplace_back(make_callback<Size>(static_cast<std::uint64_t>(i)));
+    }
+
+    std::uint64_t total = 0;
+
+    for (auto _ : state)
+    {
+        for (auto& callback : queue)
+        {
+            total = callback(total);
+        }
+    }
+
+    benchmark::DoNotOptimize(total);
+    state.SetItemsProcessed(state.iterations() * queue_length);
+}
+
+using std_function_t = std::function<std::uint64_t(std::uint64_t)>;
+using inline_function_t = inplace_function_t<std::uint64_t(std::uint64_t), 64>;
+
+BENCHMARK(enqueue_and_run<std_function_t, 8>)->Name("std_function/enqueue/8");
+BENCHMARK(enqueue_and_run<std_function_t, 16>)->Name("std_function/enqueue/16");
+BENCHMARK(enqueue_and_run<std_function_t, 32>)->Name("std_function/enqueue/32");
+BENCHMARK(enqueue_and_run<std_function_t, 64>)->Name("std_function/enqueue/64");
+BENCHMARK(enqueue_and_run<inline_function_t, 8>)->Name("inplace_function/enqueue/8");
+BENCHMARK(enqueue_and_run<inline_function_t, 16>)->Name("inplace_function/enqueue/16");
+BENCHMARK(enqueue_and_run<inline_function_t, 32>)->Name("inplace_function/enqueue/32");
+BENCHMARK(enqueue_and_run<inline_function_t, 64>)->Name("inplace_function/enqueue/64");
+BENCHMARK(invoke_only<std_function_t, 32>)->Name("std_function/invoke/32");
+BENCHMARK(invoke_only<inline_function_t, 32>)->Name("inplace_function/invoke/32");
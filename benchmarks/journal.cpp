@@ -0,0 +1,117 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "journal.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/// \cond
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+static const std::filesystem::path benchmark_directory = std::filesystem::temp_directory_path() / "utils-journal-bench";
+
+// The logger this replaces: frames copied into a file under a mutex with
+// one write per frame.
+class locked_log_t
+{
+public:
+    explicit locked_log_t(const std::filesystem::path& path)
+        : m_descriptor(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644))
+    {}
+
+    locked_log_t(const locked_log_t&) = delete;
+    locked_log_t(locked_log_t&&) = delete;
+
+    ~locked_log_t()
+    {
+        ::close(m_descriptor);
+    }
+
+    locked_log_t& operator=(const locked_log_t&) = delete;
+    locked_log_t& operator=(locked_log_t&&) = delete;
+
+    bool append(std::uint32_t stream, std::string_view message)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto length = static_cast<std::uint32_t>(message.size());
+        iovec vectors[3] = {{&stream, sizeof(stream)}, {&length, sizeof(length)}, {const_cast<char*>(message.data()), message.size()}};  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+
+        return ::writev(m_descriptor, vectors, 3) != -1;
+    }
+
+private:
+    std::mutex m_mutex;
+    int m_descriptor;
+};
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static std::unique_ptr<journal_t> shared_journal;
+static std::unique_ptr<locked_log_t> shared_log;
+
+static void journal_append(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        std::filesystem::remove_all(benchmark_directory);
+        shared_journal = std::make_unique<journal_t>(std::move(*journal_t::create(benchmark_directory)));
+    }
+
+    std::string message(static_cast<std::size_t>(state.range(0)), 'j');
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(shared_journal->append(static_cast<std::uint32_t>(state.thread_index()), message).has_value());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+
+    if (state.thread_index() == 0)
+    {
+        shared_journal.reset();
+        std::filesystem::remove_all(benchmark_directory);
+    }
+}
+
+static void locked_append(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        std::filesystem::create_directories(benchmark_directory);
+        shared_log = std::make_unique<locked_log_t>(benchmark_directory / "log");
+    }
+
+    std::string message(static_cast<std::size_t>(state.range(0)), 'l');
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(shared_log->append(static_cast<std::uint32_t>(state.thread_index()), message));
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+
+    if (state.thread_index() == 0)
+    {
+        shared_log.reset();
+        std::filesystem::remove_all(benchmark_directory);
+    }
+}
+
+// Fixed iterations bound the disk each run fills.
+BENCHMARK(locked_append)->Arg(64)->Arg(512)->ThreadRange(1, 4)->Iterations(1 << 18)->UseRealTime();
+BENCHMARK(journal_append)->Arg(64)->Arg(512)->ThreadRange(1, 4)->Iterations(1 << 18)->UseRealTime();
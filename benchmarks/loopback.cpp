@@ -0,0 +1,108 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "http.hpp"
+#include "loopback.hpp"
+#include "output_buffer.hpp"
+
+#include <fcntl.h>
+
+/// \cond
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static constexpr std::string_view pipelined_request = "GET /api/v1/metrics?window=60s&format=json HTTP/1.1\r\n"
+                                                      "Host: admin.internal.example.com:8443\r\n"
+                                                      "Accept: application/json\r\n"
+                                                      "Connection: keep-alive\r\n"
+                                                      "\r\n";
+
+static constexpr std::size_t pipe_capacity = 64 * 1024;
+
+static std::pair<socket_t, socket_t> socket_pair()
+{
+    auto sockets = socket_t::pair();
+
+    ::fcntl(sockets->first.descriptor(), F_SETFL, O_NONBLOCK);
+    ::fcntl(sockets->second.descriptor(), F_SETFL, O_NONBLOCK);
+
+    return std::move(*sockets);
+}
+
+static std::pair<loopback_t, loopback_t> loopback_pair()
+{
+    auto pipe = loopback_t::pair(pipe_capacity, false);
+    return std::move(*pipe);
+}
+
+// One event-loop turn of a pipelined HTTP client and server on a single
+// thread: queue a batch of requests, flush them, then receive and parse
+// until the batch is consumed. Only the transport differs between runs.
+template <auto Factory>
+static void http_round(benchmark::State& state)
+{
+    auto [client, server] = Factory();
+    auto batch = static_cast<std::size_t>(state.range(0));
+
+    output_buffer_t output(pipe_capacity, pipe_capacity * 4);
+    http_parser_t parser;
+    std::vector<char> buffer(pipe_capacity);
+    std::size_t filled = 0;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < batch; ++i)
+        {
+            output.append_reference(pipelined_request.data(), pipelined_request.size());
+        }
+
+        std::size_t parsed = 0;
+
+        while (parsed < batch)
+        {
+            if (!output.empty())
+            {
+                std::ignore = output.flush(client);
+            }
+
+            auto received = server.recv(buffer.data() + filled, buffer.size() - filled);
+            filled += received ? *received : 0;
+
+            std::string_view remaining(buffer.data(), filled);
+
+            for (;;)
+            {
+                auto request = parser.parse(remaining);
+
+                if (!request)
+                {
+                    break;
+                }
+
+                remaining.remove_prefix(request->size);
+                ++parsed;
+            }
+
+            filled = remaining.size();
+            std::memmove(buffer.data(), remaining.data(), filled);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(pipelined_request.size()));
+}
+
+BENCHMARK(http_round<socket_pair>)->Name("http_round/socket_t")->Arg(1)->Arg(64)->Arg(512);
+BENCHMARK(http_round<loopback_pair>)->Name("http_round/loopback_t")->Arg(1)->Arg(64)->Arg(512);
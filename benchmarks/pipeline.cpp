@@ -0,0 +1,105 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "pipeline.hpp"
+
+/// \cond
+#include <cstddef>
+#include <string>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static maybe_t<std::string> trim(std::string&& text)
+{
+    if (text.empty())
+    {
+        return utils::nothing;
+    }
+
+    text.pop_back();
+    return maybe_t<std::string>(std::move(text));
+}
+
+static maybe_t<std::string> widen(std::string&& text)
+{
+    text.push_back('!');
+    return maybe_t<std::string>(std::move(text));
+}
+
+static maybe_t<std::string> fallback()
+{
+    return maybe_t<std::string>(std::string("default value that does not fit in sso"));
+}
+
+static maybe_t<std::string> make_input(benchmark::State& state)
+{
+    if (state.range(0) == 0)
+    {
+        return utils::nothing;
+    }
+
+    return maybe_t<std::string>(std::string("a long enough input string to leave sso"));
+}
+
+static void member_chain(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto input = make_input(state);
+        maybe_t<std::string> result = std::move(input).and_then(trim).and_then(widen).and_then(trim).or_else(fallback);
+
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void pipeline_chain(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto input = make_input(state);
+        maybe_t<std::string> result = std::move(input) | and_then(trim) | and_then(widen) | and_then(trim) | or_else(fallback);
+
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+static void handwritten_chain(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto input = make_input(state);
+        maybe_t<std::string> result = utils::nothing;
+
+        if (input.has_value())
+        {
+            auto first = trim(std::move(*input));
+
+            if (first.has_value())
+            {
+                auto second = widen(std::move(*first));
+
+                if (second.has_value())
+                {
+                    result = trim(std::move(*second));
+                }
+            }
+        }
+
+        if (!result.has_value())
+        {
+            result = fallback();
+        }
+
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(member_chain)->Arg(0)->Arg(1);
+BENCHMARK(pipeline_chain)->Arg(0)->Arg(1);
+BENCHMARK(handwritten_chain)->Arg(0)->Arg(1);
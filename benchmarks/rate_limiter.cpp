@@ -0,0 +1,106 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "rate_limiter.hpp"
+
+/// \cond
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+static constexpr double benchmark_rate = 1e11;
+static constexpr std::size_t benchmark_burst = 1 << 20;
+
+// The usual mutex-guarded bucket that refills from steady_clock on every
+// call.
+class locked_bucket_t
+{
+public:
+    locked_bucket_t(double tokens_per_second, std::size_t burst)
+        : m_rate(tokens_per_second)
+        , m_burst(static_cast<double>(burst))
+        , m_tokens(m_burst)
+        , m_last(std::chrono::steady_clock::now())
+    {}
+
+    bool try_acquire(std::size_t tokens = 1)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto now = std::chrono::steady_clock::now();
+        m_tokens = std::min(m_burst, m_tokens + std::chrono::duration<double>(now - m_last).count() * m_rate);
+        m_last = now;
+
+        if (m_tokens < static_cast<double>(tokens))
+        {
+            return false;
+        }
+
+        m_tokens -= static_cast<double>(tokens);
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    double m_rate;
+    double m_burst;
+    double m_tokens;
+    std::chrono::steady_clock::time_point m_last;
+};
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+template <typename Clock>
+static void clock_now(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Clock::now());
+    }
+}
+
+template <typename Bucket>
+static Bucket& shared_bucket()
+{
+    static Bucket bucket(benchmark_rate, benchmark_burst);
+    return bucket;
+}
+
+template <typename Bucket>
+static void acquire(benchmark::State& state)
+{
+    auto& bucket = shared_bucket<Bucket>();
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(bucket.try_acquire(16));
+    }
+}
+
+static void acquire_cached(benchmark::State& state)
+{
+    token_cache_t<> cache(shared_bucket<token_bucket_t<>>(), 1024);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cache.try_acquire(16));
+    }
+}
+
+BENCHMARK(clock_now<std::chrono::steady_clock>)->Name("steady_clock");
+BENCHMARK(clock_now<coarse_clock_t>)->Name("coarse_clock");
+BENCHMARK(clock_now<tsc_clock_t>)->Name("tsc_clock");
+BENCHMARK(acquire<locked_bucket_t>)->Name("locked_bucket")->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(acquire<token_bucket_t<std::chrono::steady_clock>>)->Name("token_bucket/steady_clock")->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(acquire<token_bucket_t<coarse_clock_t>>)->Name("token_bucket/coarse_clock")->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(acquire<token_bucket_t<>>)->Name("token_bucket/tsc_clock")->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(acquire_cached)->Name("token_cache/tsc_clock")->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,110 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "result.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+struct Frame
+{
+    explicit Frame(std::size_t size, char fill)
+        : length(size)
+    {
+        std::memset(bytes.data(), fill, size);
+    }
+
+    std::array<char, 2048> bytes;
+    std::size_t length;
+};
+
+struct Message
+{
+    std::string header;
+    std::string body;
+};
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+[[gnu::noinline]] static result_t<Frame, std::errc> frame_wrapped(std::size_t size)
+{
+    return success_t<Frame>(Frame(size, 'x'));
+}
+
+[[gnu::noinline]] static result_t<Frame, std::errc> frame_emplaced(std::size_t size)
+{
+    return emplace_success<Frame>(size, 'x');
+}
+
+[[gnu::noinline]] static result_t<Message, std::errc> message_wrapped(const std::string& header, const std::string& body)
+{
+    return success_t<Message>(Message{header, body});
+}
+
+[[gnu::noinline]] static result_t<Message, std::errc> message_emplaced(const std::string& header, const std::string& body)
+{
+    return emplace_success<Message>(header, body);
+}
+
+static void frame_success_t(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto result = frame_wrapped(size);
+        benchmark::DoNotOptimize(result->bytes.data());
+    }
+}
+
+static void frame_in_place(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto result = frame_emplaced(size);
+        benchmark::DoNotOptimize(result->bytes.data());
+    }
+}
+
+static void message_success_t(benchmark::State& state)
+{
+    std::string header(64, 'h');
+    std::string body(static_cast<std::size_t>(state.range(0)), 'b');
+
+    for (auto _ : state)
+    {
+        auto result = message_wrapped(header, body);
+        benchmark::DoNotOptimize(result->body.data());
+    }
+}
+
+static void message_in_place(benchmark::State& state)
+{
+    std::string header(64, 'h');
+    std::string body(static_cast<std::size_t>(state.range(0)), 'b');
+
+    for (auto _ : state)
+    {
+        auto result = message_emplaced(header, body);
+        benchmark::DoNotOptimize(result->body.data());
+    }
+}
+
+BENCHMARK(frame_success_t)->Arg(64)->Arg(2048);
+BENCHMARK(frame_in_place)->Arg(64)->Arg(2048);
+BENCHMARK(message_success_t)->Arg(16)->Arg(4096);
+BENCHMARK(message_in_place)->Arg(16)->Arg(4096);
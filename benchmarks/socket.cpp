@@ -0,0 +1,252 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "output_buffer.hpp"
+#include "socket.hpp"
+
+/// \cond
+#include <netinet/tcp.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+static std::pair<socket_t, socket_t> tcp_pair()
+{
+    socket_t server;
+
+    std::ignore = server.bind("127.0.0.1", 0);
+    std::ignore = server.listen(1);
+
+    socket_t client;
+    std::ignore = client.connect(*server.local_endpoint());
+
+    int enable = 1;
+    ::setsockopt(client.descriptor(), IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    auto accepted = server.accept();
+    socket_t peer = std::move(*accepted);
+    ::setsockopt(peer.descriptor(), IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    return {std::move(client), std::move(peer)};
+}
+
+static std::pair<socket_t, socket_t> local_pair()
+{
+    auto sockets = socket_t::pair();
+    return std::move(*sockets);
+}
+
+static bool recv_exact(const socket_t& socket, std::byte* data, std::size_t length)
+{
+    while (length != 0)
+    {
+        auto received = socket.recv(data, length);
+
+        if (!received || *received == 0)
+        {
+            return false;
+        }
+
+        data += *received;
+        length -= *received;
+    }
+
+    return true;
+}
+
+template <auto Factory>
+static void ping_pong(benchmark::State& state)
+{
+    auto [client, peer] = Factory();
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    std::jthread echo([&peer, size] {
+        std::vector<std::byte> buffer(size);
+
+        while (recv_exact(peer, buffer.data(), size))
+        {
+            std::ignore = peer.send(buffer.data(), size);
+        }
+    });
+
+    std::vector<std::byte> buffer(size);
+
+    for (auto _ : state)
+    {
+        std::ignore = client.send(buffer.data(), size);
+        recv_exact(client, buffer.data(), size);
+    }
+
+    client.close();
+    echo.join();
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2);
+}
+
+template <auto Factory>
+static void stream(benchmark::State& state)
+{
+    auto [client, peer] = Factory();
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    std::jthread sink([&peer] {
+        std::vector<std::byte> buffer(1 << 16);
+
+        for (;;)
+        {
+            auto received = peer.recv(buffer.data(), buffer.size());
+
+            if (!received || *received == 0)
+            {
+                break;
+            }
+        }
+    });
+
+    std::vector<std::byte> buffer(size);
+
+    for (auto _ : state)
+    {
+        std::size_t sent = 0;
+
+        while (sent < size)
+        {
+            auto result = client.send(buffer.data() + sent, size - sent);
+            sent += result ? *result : size;
+        }
+    }
+
+    client.close();
+    sink.join();
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static bool recv_exact(const socket_t& socket, std::byte* data, std::size_t length, const busy_poll_t& policy)
+{
+    while (length != 0)
+    {
+        auto received = socket.recv(data, length, policy);
+
+        if (!received || *received == 0)
+        {
+            return false;
+        }
+
+        data += *received;
+        length -= *received;
+    }
+
+    return true;
+}
+
+// Both ends spin for range(0) microseconds before blocking; comparing real
+// and process CPU time shows how much CPU each microsecond saved costs.
+template <auto Factory>
+static void ping_pong_spin(benchmark::State& state)
+{
+    static constexpr std::size_t size = 64;
+
+    auto [client, peer] = Factory();
+    busy_poll_t policy{std::chrono::microseconds(state.range(0))};
+
+    std::jthread echo([&peer, policy] {
+        std::array<std::byte, size> buffer{};
+
+        while (recv_exact(peer, buffer.data(), size, policy))
+        {
+            std::ignore = peer.send(buffer.data(), size);
+        }
+    });
+
+    std::array<std::byte, size> buffer{};
+
+    for (auto _ : state)
+    {
+        std::ignore = client.send(buffer.data(), size);
+        recv_exact(client, buffer.data(), size, policy);
+    }
+
+    client.close();
+    echo.join();
+}
+
+// Each response is range(0) small fragments, sent either one syscall per
+// fragment or gathered in an output_buffer_t and flushed once.
+template <bool Corked>
+static void fragmented_response(benchmark::State& state)
+{
+    static constexpr std::string_view fragment = "X-Header: value-value-value\r\n";
+
+    auto [client, peer] = local_pair();
+
+    std::jthread sink([&peer] {
+        std::vector<std::byte> buffer(1 << 16);
+
+        for (;;)
+        {
+            auto received = peer.recv(buffer.data(), buffer.size());
+
+            if (!received || *received == 0)
+            {
+                break;
+            }
+        }
+    });
+
+    output_buffer_t output;
+    std::size_t syscalls = 0;
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            if constexpr (Corked)
+            {
+                output.append(fragment);
+            }
+            else
+            {
+                std::ignore = client.send(fragment);
+                ++syscalls;
+            }
+        }
+
+        if constexpr (Corked)
+        {
+            while (!output.empty())
+            {
+                std::ignore = output.flush(client);
+                ++syscalls;
+            }
+        }
+    }
+
+    client.close();
+    sink.join();
+
+    state.counters["syscalls"] = benchmark::Counter(static_cast<double>(syscalls), benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(fragment.size()));
+}
+
+BENCHMARK(ping_pong<tcp_pair>)->Range(8, 1 << 14)->UseRealTime();
+BENCHMARK(ping_pong<local_pair>)->Range(8, 1 << 14)->UseRealTime();
+BENCHMARK(stream<tcp_pair>)->Range(1 << 10, 1 << 20)->UseRealTime();
+BENCHMARK(stream<local_pair>)->Range(1 << 10, 1 << 20)->UseRealTime();
+BENCHMARK(ping_pong_spin<tcp_pair>)->Arg(0)->Arg(10)->Arg(100)->UseRealTime()->MeasureProcessCPUTime();
+BENCHMARK(ping_pong_spin<local_pair>)->Arg(0)->Arg(10)->Arg(100)->UseRealTime()->MeasureProcessCPUTime();
+BENCHMARK(fragmented_response<false>)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
+BENCHMARK(fragmented_response<true>)->Arg(4)->Arg(16)->Arg(64)->UseRealTime();
@@ -0,0 +1,162 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "try.hpp"
+
+/// \cond
+#include <stdexcept>
+#include <string>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+struct Record
+{
+    std::string name;
+    long score;
+};
+
+using record_result_t = result_t<Record, int>;
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+[[gnu::noinline]] static Record throwing_leaf(long input)
+{
+    if (input < 0)
+    {
+        throw std::runtime_error("negative input");
+    }
+
+    return Record{"record", input};
+}
+
+[[gnu::noinline]] static Record throwing_layer(long input, int depth)
+{
+    if (depth == 0)
+    {
+        return throwing_leaf(input);
+    }
+
+    auto record = throwing_layer(input, depth - 1);
+    record.score += 1;
+
+    return record;
+}
+
+[[gnu::noinline]] static record_result_t manual_leaf(long input)
+{
+    if (input < 0)
+    {
+        return fail_t<int>(-1);
+    }
+
+    return success_t<Record>(Record{"record", input});
+}
+
+[[gnu::noinline]] static record_result_t manual_layer(long input, int depth)
+{
+    if (depth == 0)
+    {
+        return manual_leaf(input);
+    }
+
+    auto result = manual_layer(input, depth - 1);
+
+    if (!result.has_value())
+    {
+        return fail_t<int>(result.error());
+    }
+
+    Record record = result.value();
+    record.score += 1;
+
+    return success_t<Record>(std::move(record));
+}
+
+[[gnu::noinline]] static record_result_t try_layer(long input, int depth)
+{
+    if (depth == 0)
+    {
+        return manual_leaf(input);
+    }
+
+    auto record = TRY(try_layer(input, depth - 1));
+    record.score += 1;
+
+    return success_t<Record>(std::move(record));
+}
+
+[[gnu::noinline]] static record_result_t await_layer(long input, int depth)
+{
+    if (depth == 0)
+    {
+        co_return co_await manual_leaf(input);
+    }
+
+    auto record = co_await await_layer(input, depth - 1);
+    record.score += 1;
+
+    co_return record;
+}
+
+static constexpr int stack_depth = 5;
+
+static void exception_path(benchmark::State& state)
+{
+    long input = state.range(0);
+
+    for (auto _ : state)
+    {
+        try
+        {
+            benchmark::DoNotOptimize(throwing_layer(input, stack_depth).score);
+        }
+        catch (const std::runtime_error& error)
+        {
+            benchmark::DoNotOptimize(error.what());
+        }
+    }
+}
+
+static void manual_path(benchmark::State& state)
+{
+    long input = state.range(0);
+
+    for (auto _ : state)
+    {
+        auto result = manual_layer(input, stack_depth);
+        benchmark::DoNotOptimize(result.has_value());
+    }
+}
+
+static void try_path(benchmark::State& state)
+{
+    long input = state.range(0);
+
+    for (auto _ : state)
+    {
+        auto result = try_layer(input, stack_depth);
+        benchmark::DoNotOptimize(result.has_value());
+    }
+}
+
+static void await_path(benchmark::State& state)
+{
+    long input = state.range(0);
+
+    for (auto _ : state)
+    {
+        auto result = await_layer(input, stack_depth);
+        benchmark::DoNotOptimize(result.has_value());
+    }
+}
+
+BENCHMARK(exception_path)->Arg(1)->Arg(-1);
+BENCHMARK(manual_path)->Arg(1)->Arg(-1);
+BENCHMARK(try_path)->Arg(1)->Arg(-1);
+BENCHMARK(await_path)->Arg(1)->Arg(-1);
@@ -0,0 +1,212 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "wire.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+struct quote_t
+{
+    std::uint64_t id;
+    std::string symbol;
+    maybe_t<double> bid;
+    maybe_t<double> ask;
+    result_t<std::uint32_t, std::int16_t> status;
+    std::uint64_t timestamp;
+};
+
+/*****************************************************************************/
+/*** BENCHMARKS **************************************************************/
+
+// The hand-rolled equivalent of what a careful author writes without the
+// serializer: one tag byte per optional field and explicit memcpy calls.
+[[gnu::noinline]] static std::size_t manual_encode(const quote_t& quote, std::byte* out)
+{
+    std::byte* start = out;
+
+    auto put = [&](const void* data, std::size_t length) {
+        std::memcpy(out, data, length);
+        out += length;
+    };
+
+    auto length = static_cast<std::uint32_t>(quote.symbol.size());
+    auto has_bid = static_cast<std::uint8_t>(quote.bid.has_value());
+    auto has_ask = static_cast<std::uint8_t>(quote.ask.has_value());
+    auto succeeded = static_cast<std::uint8_t>(quote.status.has_value());
+
+    put(&quote.id, sizeof(quote.id));
+    put(&length, sizeof(length));
+    put(quote.symbol.data(), length);
+    put(&has_bid, 1);
+
+    if (has_bid != 0)
+    {
+        put(&*quote.bid, sizeof(double));
+    }
+
+    put(&has_ask, 1);
+
+    if (has_ask != 0)
+    {
+        put(&*quote.ask, sizeof(double));
+    }
+
+    put(&succeeded, 1);
+
+    if (succeeded != 0)
+    {
+        put(&quote.status.value(), sizeof(std::uint32_t));
+    }
+    else
+    {
+        put(&quote.status.error(), sizeof(std::int16_t));
+    }
+
+    put(&quote.timestamp, sizeof(quote.timestamp));
+
+    return static_cast<std::size_t>(out - start);
+}
+
+[[gnu::noinline]] static double manual_decode(const std::byte* data)
+{
+    std::uint64_t id = 0;
+    std::uint32_t length = 0;
+    double bid = 0;
+    double ask = 0;
+
+    std::memcpy(&id, data, sizeof(id));
+    data += sizeof(id);
+    std::memcpy(&length, data, sizeof(length));
+    data += sizeof(length) + length;
+
+    if (std::to_integer<int>(*data++) != 0)
+    {
+        std::memcpy(&bid, data, sizeof(bid));
+        data += sizeof(bid);
+    }
+
+    if (std::to_integer<int>(*data++) != 0)
+    {
+        std::memcpy(&ask, data, sizeof(ask));
+    }
+
+    return static_cast<double>(id) + bid + ask + length;
+}
+
+[[gnu::noinline]] static std::size_t wire_encode(const quote_t& quote, std::span<std::byte> out)
+{
+    return *encode(quote, out);
+}
+
+[[gnu::noinline]] static double wire_decode(std::span<const std::byte> data)
+{
+    auto view = wire_view_t<quote_t>::parse(data);
+
+    if (!view.has_value())
+    {
+        return 0;
+    }
+
+    auto bid = view->get<2>();
+    auto ask = view->get<3>();
+
+    return static_cast<double>(view->get<0>()) + (bid.has_value() ? *bid : 0) + (ask.has_value() ? *ask : 0)
+         + static_cast<double>(view->get<1>().size());
+}
+
+static quote_t sample_quote()
+{
+    return quote_t{1234, "ACME", 101.25, 101.5, success_t<std::uint32_t>(7U), 1700000000};
+}
+
+static void manual_round_trip(benchmark::State& state)
+{
+    auto quote = sample_quote();
+    std::array<std::byte, 128> buffer{};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(manual_encode(quote, buffer.data()));
+        benchmark::DoNotOptimize(manual_decode(buffer.data()));
+    }
+}
+
+static void wire_round_trip(benchmark::State& state)
+{
+    auto quote = sample_quote();
+    std::array<std::byte, 128> buffer{};
+
+    for (auto _ : state)
+    {
+        auto length = wire_encode(quote, buffer);
+        benchmark::DoNotOptimize(length);
+        benchmark::DoNotOptimize(wire_decode(std::span<const std::byte>(buffer.data(), length)));
+    }
+}
+
+static void manual_encode_only(benchmark::State& state)
+{
+    auto quote = sample_quote();
+    std::array<std::byte, 128> buffer{};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(manual_encode(quote, buffer.data()));
+        benchmark::ClobberMemory();
+    }
+}
+
+static void wire_encode_only(benchmark::State& state)
+{
+    auto quote = sample_quote();
+    std::array<std::byte, 128> buffer{};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(wire_encode(quote, buffer));
+        benchmark::ClobberMemory();
+    }
+}
+
+static void manual_decode_only(benchmark::State& state)
+{
+    auto quote = sample_quote();
+    std::array<std::byte, 128> buffer{};
+    manual_encode(quote, buffer.data());
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(manual_decode(buffer.data()));
+    }
+}
+
+static void wire_decode_only(benchmark::State& state)
+{
+    auto quote = sample_quote();
+    std::array<std::byte, 128> buffer{};
+    auto length = wire_encode(quote, buffer);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(wire_decode(std::span<const std::byte>(buffer.data(), length)));
+    }
+}
+
+BENCHMARK(manual_round_trip);
+BENCHMARK(wire_round_trip);
+BENCHMARK(manual_encode_only);
+BENCHMARK(wire_encode_only);
+BENCHMARK(manual_decode_only);
+BENCHMARK(wire_decode_only);
@@ -0,0 +1,458 @@
+#ifndef ATOMIC_MAYBE_HPP
+#define ATOMIC_MAYBE_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "maybe.hpp"
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+namespace rcu
+{
+    inline constexpr std::size_t max_readers = 256;
+
+    struct alignas(64) reader_slot_t
+    {
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> claimed{false};
+    };
+
+    // Epoch-based reclamation shared by every atomic_maybe_t. A reader
+    // publishes the epoch it started in to a slot of its own, so read-side
+    // sections never write to a shared cache line. Threads beyond
+    // max_readers share the overflow counter instead, which holds off all
+    // reclamation while any of them is inside a section.
+    struct domain_t
+    {
+        std::atomic<std::uint64_t> epoch{1};
+        std::atomic<std::uint64_t> overflow{0};
+        std::array<reader_slot_t, max_readers> slots;
+    };
+
+    struct registration_t
+    {
+        registration_t();
+
+        registration_t(const registration_t&) = delete;
+        registration_t(registration_t&&) = delete;
+
+        ~registration_t();
+
+        registration_t& operator=(const registration_t&) = delete;
+        registration_t& operator=(registration_t&&) = delete;
+
+        std::size_t index = max_readers;
+        std::size_t depth = 0;
+    };
+}  // namespace rcu
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+namespace rcu
+{
+    inline domain_t& domain() noexcept
+    {
+        static domain_t instance;
+        return instance;
+    }
+
+    inline registration_t::registration_t()
+    {
+        auto& slots = domain().slots;
+
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+            bool expected = false;
+
+            if (!slots[i].claimed.load(std::memory_order_relaxed)
+                && slots[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                index = i;
+                break;
+            }
+        }
+    }
+
+    inline registration_t::~registration_t()
+    {
+        if (index < max_readers)
+        {
+            domain().slots[index].claimed.store(false, std::memory_order_release);
+        }
+    }
+
+    inline registration_t& registration() noexcept
+    {
+        thread_local registration_t instance;
+        return instance;
+    }
+
+    /// Oldest epoch a reader may still be using: objects retired in an
+    /// epoch at or below it can be freed.
+    inline std::uint64_t oldest_reader() noexcept
+    {
+        auto& state = domain();
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (state.overflow.load(std::memory_order_acquire) != 0)
+        {
+            return 0;
+        }
+
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+
+        for (const auto& slot : state.slots)
+        {
+            std::uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+
+            if (epoch != 0)
+            {
+                oldest = std::min(oldest, epoch);
+            }
+        }
+
+        return oldest == std::numeric_limits<std::uint64_t>::max() ? oldest : oldest - 1;
+    }
+
+    /// Starts a new epoch and returns the one objects unlinked before the
+    /// call were retired in.
+    inline std::uint64_t advance() noexcept
+    {
+        return domain().epoch.fetch_add(1, std::memory_order_seq_cst);
+    }
+}  // namespace rcu
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+namespace rcu
+{
+    // A read-side critical section. Entering and leaving take a fixed number
+    // of steps and never wait for writers; sections nest.
+    class guard_t
+    {
+    public:
+        guard_t() noexcept
+            : m_registration(registration())
+        {
+            if (m_registration.depth++ != 0)
+            {
+                return;
+            }
+
+            auto& state = domain();
+
+            if (m_registration.index < max_readers)
+            {
+                state.slots[m_registration.index].epoch.store(state.epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            else
+            {
+                state.overflow.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        guard_t(const guard_t&) = delete;
+        guard_t(guard_t&&) = delete;
+
+        ~guard_t()
+        {
+            if (--m_registration.depth != 0)
+            {
+                return;
+            }
+
+            auto& state = domain();
+
+            if (m_registration.index < max_readers)
+            {
+                state.slots[m_registration.index].epoch.store(0, std::memory_order_release);
+            }
+            else
+            {
+                state.overflow.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        guard_t& operator=(const guard_t&) = delete;
+        guard_t& operator=(guard_t&&) = delete;
+
+    private:
+        registration_t& m_registration;
+    };
+}  // namespace rcu
+
+template <typename T>
+inline constexpr bool is_packable_v = std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>
+                                   && sizeof(T) < sizeof(std::uint64_t) && alignof(T) <= alignof(std::uint64_t);
+
+// A maybe_t that threads can read while another thread replaces or clears
+// it. Reads are wait-free and take no reference count: read() hands the
+// callback a maybe_t<const T&> that stays valid until the callback returns,
+// and load() copies the value out.
+//
+// Values live on the heap and are swapped in with a single pointer
+// exchange. A replaced value is freed by a later store (or the destructor)
+// once every reader that might still see it has left its rcu::guard_t, so
+// a reader never blocks a writer and a writer never waits for readers.
+// Writers are serialized with a mutex.
+//
+// This is the path for every T that is_packable_v rejects, which includes
+// word-sized values such as std::int64_t, double and pointers: the packed
+// form needs a spare byte for the presence flag. Floating-point types and
+// types with padding are rejected as well, as equal values of them can
+// differ bytewise.
+template <typename T>
+class atomic_maybe_t
+{
+    struct retired_t
+    {
+        const T* pointer;
+        std::uint64_t epoch;
+    };
+
+public:
+    using value_type = T;
+
+    atomic_maybe_t() noexcept = default;
+
+    explicit atomic_maybe_t(T value)
+        : m_pointer(new T(std::move(value)))
+    {}
+
+    atomic_maybe_t(const atomic_maybe_t&) = delete;
+    atomic_maybe_t(atomic_maybe_t&&) = delete;
+
+    ~atomic_maybe_t()
+    {
+        delete m_pointer.load(std::memory_order_relaxed);
+
+        for (const auto& retired : m_retired)
+        {
+            delete retired.pointer;
+        }
+    }
+
+    atomic_maybe_t& operator=(const atomic_maybe_t&) = delete;
+    atomic_maybe_t& operator=(atomic_maybe_t&&) = delete;
+
+    template <typename F>
+    decltype(auto) read(F&& fn) const
+    {
+        rcu::guard_t guard;
+        const T* pointer = m_pointer.load(std::memory_order_acquire);
+
+        if (pointer == nullptr)
+        {
+            return std::invoke(std::forward<F>(fn), maybe_t<const T&>(utils::nothing));
+        }
+
+        return std::invoke(std::forward<F>(fn), maybe_t<const T&>(*pointer));
+    }
+
+    [[nodiscard]] maybe_t<T> load() const
+    {
+        return this->read([](maybe_t<const T&> value) {
+            return value.has_value() ? maybe_t<T>(*value) : maybe_t<T>(utils::nothing);
+        });
+    }
+
+    [[nodiscard]] bool has_value() const noexcept
+    {
+        return m_pointer.load(std::memory_order_acquire) != nullptr;
+    }
+
+    void store(T value)
+    {
+        publish(new T(std::move(value)));
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        publish(new T(std::forward<Args>(args)...));
+    }
+
+    void reset()
+    {
+        publish(nullptr);
+    }
+
+    /// Number of replaced values still waiting for readers to move on.
+    [[nodiscard]] std::size_t retired() const
+    {
+        std::lock_guard<std::mutex> lock(m_writer);
+        return m_retired.size();
+    }
+
+private:
+    void publish(const T* fresh)
+    {
+        std::lock_guard<std::mutex> lock(m_writer);
+
+        const T* previous = m_pointer.exchange(fresh, std::memory_order_acq_rel);
+
+        if (previous != nullptr)
+        {
+            m_retired.push_back(retired_t{previous, rcu::advance()});
+        }
+
+        collect();
+    }
+
+    void collect()
+    {
+        if (m_retired.empty())
+        {
+            return;
+        }
+
+        std::uint64_t oldest = rcu::oldest_reader();
+
+        auto reclaimable = std::stable_partition(m_retired.begin(), m_retired.end(), [oldest](const retired_t& retired) {
+            return retired.epoch > oldest;
+        });
+
+        for (auto it = reclaimable; it != m_retired.end(); ++it)
+        {
+            delete it->pointer;
+        }
+
+        m_retired.erase(reclaimable, m_retired.end());
+    }
+
+    std::atomic<const T*> m_pointer{nullptr};
+    mutable std::mutex m_writer;
+    std::vector<retired_t> m_retired;
+};
+
+// Values smaller than a word whose bytes determine their value are packed
+// into one atomic word together with their presence flag, so every
+// operation is a single atomic instruction.
+template <typename T>
+    requires(is_packable_v<T>)
+class atomic_maybe_t<T>
+{
+    static constexpr std::size_t flag_offset = sizeof(std::uint64_t) - 1;
+
+public:
+    using value_type = T;
+
+    atomic_maybe_t() noexcept = default;
+
+    explicit atomic_maybe_t(T value) noexcept
+        : m_word(pack(value))
+    {}
+
+    atomic_maybe_t(const atomic_maybe_t&) = delete;
+    atomic_maybe_t(atomic_maybe_t&&) = delete;
+
+    ~atomic_maybe_t() = default;
+
+    atomic_maybe_t& operator=(const atomic_maybe_t&) = delete;
+    atomic_maybe_t& operator=(atomic_maybe_t&&) = delete;
+
+    template <typename F>
+    decltype(auto) read(F&& fn) const
+    {
+        auto value = this->load();
+
+        if (!value.has_value())
+        {
+            return std::invoke(std::forward<F>(fn), maybe_t<const T&>(utils::nothing));
+        }
+
+        return std::invoke(std::forward<F>(fn), maybe_t<const T&>(*value));
+    }
+
+    [[nodiscard]] maybe_t<T> load() const noexcept
+    {
+        return unpack(m_word.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] bool has_value() const noexcept
+    {
+        return present(m_word.load(std::memory_order_acquire));
+    }
+
+    void store(T value) noexcept
+    {
+        m_word.store(pack(value), std::memory_order_release);
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+    {
+        this->store(T(std::forward<Args>(args)...));
+    }
+
+    void reset() noexcept
+    {
+        m_word.store(0, std::memory_order_release);
+    }
+
+    /// Replaces the value with desired if it currently equals expected, both
+    /// compared bytewise with absence as a distinct state.
+    bool compare_exchange(const maybe_t<T>& expected, const maybe_t<T>& desired) noexcept
+    {
+        std::uint64_t word = expected.has_value() ? pack(*expected) : 0;
+        return m_word.compare_exchange_strong(word, desired.has_value() ? pack(*desired) : 0, std::memory_order_acq_rel);
+    }
+
+private:
+    static std::uint64_t pack(const T& value) noexcept
+    {
+        std::array<unsigned char, sizeof(std::uint64_t)> bytes{};
+
+        std::memcpy(bytes.data(), &value, sizeof(T));
+        bytes[flag_offset] = 1;
+
+        return std::bit_cast<std::uint64_t>(bytes);
+    }
+
+    static bool present(std::uint64_t word) noexcept
+    {
+        return std::bit_cast<std::array<unsigned char, sizeof(std::uint64_t)>>(word)[flag_offset] != 0;
+    }
+
+    static maybe_t<T> unpack(std::uint64_t word) noexcept
+    {
+        if (!present(word))
+        {
+            return utils::nothing;
+        }
+
+        auto bytes = std::bit_cast<std::array<unsigned char, sizeof(std::uint64_t)>>(word);
+        std::array<unsigned char, sizeof(T)> value{};
+        std::memcpy(value.data(), bytes.data(), sizeof(T));
+
+        return std::bit_cast<T>(value);
+    }
+
+    std::atomic<std::uint64_t> m_word{0};
+};
+
+#endif  // ATOMIC_MAYBE_HPP
@@ -0,0 +1,332 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "maybe.hpp"
+#include "parallel.hpp"
+#include "result.hpp"
+
+/// \cond
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+template <typename R>
+using range_result_t = std::remove_cvref_t<std::ranges::range_reference_t<R>>;
+
+template <typename R>
+using result_value_t = typename range_result_t<R>::value_type;
+
+template <typename R>
+using result_error_t = typename range_result_t<R>::error_type;
+
+template <typename R>
+using partition_t = std::pair<std::vector<result_value_t<R>>, std::vector<result_error_t<R>>>;
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+namespace batch
+{
+    inline constexpr std::size_t parallel_grain = 4096;
+
+    // Elements are moved out when the range yields rvalues, or when it is an
+    // rvalue container that owns them. A view over an lvalue container yields
+    // lvalue references whatever the view's own value category is, and its
+    // elements are copied.
+    template <typename R>
+    inline constexpr bool movable_elements_v = !std::is_lvalue_reference_v<std::ranges::range_reference_t<R>>
+                                            || (!std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R>>);
+
+    template <typename R, typename T>
+    constexpr auto&& take(T& item) noexcept
+    {
+        if constexpr (movable_elements_v<R>)
+        {
+            return std::move(item);
+        }
+        else
+        {
+            return item;
+        }
+    }
+
+    template <typename I>
+    std::size_t first_error(I first, std::size_t size)
+    {
+        std::atomic<std::size_t> failed{size};
+
+        for_each_chunk(size, parallel_grain, [&](std::size_t /* chunk */, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end && i < failed.load(std::memory_order_relaxed); ++i)
+            {
+                if (!first[static_cast<std::iter_difference_t<I>>(i)].has_value())
+                {
+                    std::size_t current = failed.load(std::memory_order_relaxed);
+
+                    while (i < current && !failed.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                    {}
+
+                    break;
+                }
+            }
+        });
+
+        return failed.load(std::memory_order_relaxed);
+    }
+}  // namespace batch
+
+template <std::ranges::input_range R>
+result_t<std::vector<result_value_t<R>>, result_error_t<R>> collect(R&& range)
+{
+    using value_type = result_value_t<R>;
+    using error_type = result_error_t<R>;
+
+    std::vector<value_type> values;
+
+    if constexpr (std::ranges::sized_range<R>)
+    {
+        values.reserve(std::ranges::size(range));
+    }
+
+    for (auto&& item : range)
+    {
+        if (!item.has_value()) [[unlikely]]
+        {
+            return fail_t<error_type>(batch::take<R>(item).error());
+        }
+
+        values.push_back(batch::take<R>(item).value());
+    }
+
+    return success_t<std::vector<value_type>>(std::move(values));
+}
+
+template <std::ranges::random_access_range R>
+    requires(std::ranges::sized_range<R>)
+result_t<std::vector<result_value_t<R>>, result_error_t<R>> collect(utils::parallel_t /* unused */, R&& range)
+{
+    using value_type = result_value_t<R>;
+    using error_type = result_error_t<R>;
+
+    auto first = std::ranges::begin(range);
+    auto size = static_cast<std::size_t>(std::ranges::size(range));
+
+    if (chunk_count(size, batch::parallel_grain) == 1)
+    {
+        return collect(std::forward<R>(range));
+    }
+
+    if (auto failed = batch::first_error(first, size); failed != size)
+    {
+        auto&& item = first[static_cast<std::ranges::range_difference_t<R>>(failed)];
+        return fail_t<error_type>(batch::take<R>(item).error());
+    }
+
+    std::vector<value_type> values;
+
+    if constexpr (std::is_default_constructible_v<value_type>)
+    {
+        values.resize(size);
+
+        for_each_chunk(size, batch::parallel_grain, [&](std::size_t /* chunk */, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                auto&& item = first[static_cast<std::ranges::range_difference_t<R>>(i)];
+                values[i] = batch::take<R>(item).value();
+            }
+        });
+    }
+    else
+    {
+        values.reserve(size);
+
+        for (auto&& item : range)
+        {
+            values.push_back(batch::take<R>(item).value());
+        }
+    }
+
+    return success_t<std::vector<value_type>>(std::move(values));
+}
+
+template <std::ranges::input_range R>
+partition_t<R> partition(R&& range)
+{
+    partition_t<R> result;
+
+    if constexpr (std::ranges::forward_range<R> && std::ranges::sized_range<R>)
+    {
+        std::size_t good = 0;
+
+        for (auto&& item : range)
+        {
+            good += item.has_value() ? 1U : 0U;
+        }
+
+        result.first.reserve(good);
+        result.second.reserve(static_cast<std::size_t>(std::ranges::size(range)) - good);
+    }
+
+    for (auto&& item : range)
+    {
+        if (item.has_value())
+        {
+            result.first.push_back(batch::take<R>(item).value());
+        }
+        else
+        {
+            result.second.push_back(batch::take<R>(item).error());
+        }
+    }
+
+    return result;
+}
+
+template <std::ranges::random_access_range R>
+    requires(std::ranges::sized_range<R>)
+partition_t<R> partition(utils::parallel_t /* unused */, R&& range)
+{
+    auto first = std::ranges::begin(range);
+    auto size = static_cast<std::size_t>(std::ranges::size(range));
+
+    if (chunk_count(size, batch::parallel_grain) == 1)
+    {
+        return partition(std::forward<R>(range));
+    }
+
+    std::vector<partition_t<R>> partials(chunk_count(size, batch::parallel_grain));
+
+    for_each_chunk(size, batch::parallel_grain, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto from = first + static_cast<std::ranges::range_difference_t<R>>(begin);
+        auto to = first + static_cast<std::ranges::range_difference_t<R>>(end);
+
+        if constexpr (batch::movable_elements_v<R>)
+        {
+            auto part = std::ranges::subrange(std::make_move_iterator(from), std::make_move_iterator(to));
+            partials[chunk] = partition(part);
+        }
+        else
+        {
+            auto part = std::ranges::subrange(from, to);
+            partials[chunk] = partition(part);
+        }
+    });
+
+    partition_t<R> result;
+
+    std::size_t good = 0;
+    std::size_t bad = 0;
+
+    for (const auto& partial : partials)
+    {
+        good += partial.first.size();
+        bad += partial.second.size();
+    }
+
+    result.first.reserve(good);
+    result.second.reserve(bad);
+
+    for (auto& partial : partials)
+    {
+        result.first.insert(result.first.end(), std::make_move_iterator(partial.first.begin()), std::make_move_iterator(partial.first.end()));
+        result.second.insert(result.second.end(), std::make_move_iterator(partial.second.begin()), std::make_move_iterator(partial.second.end()));
+    }
+
+    return result;
+}
+
+template <std::ranges::input_range R, typename T, typename F>
+result_t<T, result_error_t<R>> try_fold(R&& range, T init, F&& fn)
+{
+    using error_type = result_error_t<R>;
+
+    for (auto&& item : range)
+    {
+        if (!item.has_value()) [[unlikely]]
+        {
+            return fail_t<error_type>(batch::take<R>(item).error());
+        }
+
+        init = std::invoke(fn, std::move(init), batch::take<R>(item).value());
+    }
+
+    return success_t<T>(std::move(init));
+}
+
+/// The parallel variant folds every chunk starting from init and merges the
+/// partial results with combine, so init must be an identity of combine.
+template <std::ranges::random_access_range R, typename T, typename F, typename C>
+    requires(std::ranges::sized_range<R>)
+result_t<T, result_error_t<R>> try_fold(utils::parallel_t /* unused */, R&& range, T init, F&& fn, C&& combine)
+{
+    using error_type = result_error_t<R>;
+
+    auto first = std::ranges::begin(range);
+    auto size = static_cast<std::size_t>(std::ranges::size(range));
+
+    if (chunk_count(size, batch::parallel_grain) == 1)
+    {
+        return try_fold(std::forward<R>(range), std::move(init), std::forward<F>(fn));
+    }
+
+    std::atomic<std::size_t> failed{size};
+    std::vector<maybe_t<T>> partials(chunk_count(size, batch::parallel_grain), utils::nothing);
+
+    for_each_chunk(size, batch::parallel_grain, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        T acc = init;
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            auto&& item = first[static_cast<std::ranges::range_difference_t<R>>(i)];
+
+            if (!item.has_value()) [[unlikely]]
+            {
+                std::size_t current = failed.load(std::memory_order_relaxed);
+
+                while (i < current && !failed.compare_exchange_weak(current, i, std::memory_order_relaxed))
+                {}
+
+                return;
+            }
+
+            if (i > failed.load(std::memory_order_relaxed)) [[unlikely]]
+            {
+                return;
+            }
+
+            acc = std::invoke(fn, std::move(acc), batch::take<R>(item).value());
+        }
+
+        partials[chunk] = std::move(acc);
+    });
+
+    if (auto index = failed.load(std::memory_order_relaxed); index != size)
+    {
+        auto&& item = first[static_cast<std::ranges::range_difference_t<R>>(index)];
+        return fail_t<error_type>(batch::take<R>(item).error());
+    }
+
+    for (auto& partial : partials)
+    {
+        if (partial.has_value())
+        {
+            init = std::invoke(combine, std::move(init), std::move(*partial));
+        }
+    }
+
+    return success_t<T>(std::move(init));
+}
+
+#endif  // BATCH_HPP
@@ -0,0 +1,211 @@
+#ifndef BOXED_HPP
+#define BOXED_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "result.hpp"
+
+/// \cond
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Keeps a value in a heap slot behind a single pointer, for error types too
+// large to be carried inline: result_t<Value, boxed_t<Error>> is only as big
+// as Value (or a pointer), so the success path stays small while the rare
+// failure pays for the allocation.
+//
+// Slots come from a free list per thread and per type, capped at
+// pool_capacity, so a burst of failures does not hit the allocator for every
+// error. A slot freed on another thread simply joins that thread's list.
+template <typename T>
+class boxed_t
+{
+    static_assert(std::is_object_v<T> && !std::is_array_v<T>);
+
+    static constexpr std::size_t pool_capacity = 64;
+
+    struct node_t
+    {
+        node_t* next;
+    };
+
+    static constexpr std::size_t slot_size = std::max(sizeof(T), sizeof(node_t));
+    static constexpr std::align_val_t slot_alignment{std::max(alignof(T), alignof(node_t))};
+
+    struct pool_t
+    {
+        node_t* head;
+        std::size_t count;
+        bool retired;
+    };
+
+    // Returns the cached slots to the allocator when the thread exits. The
+    // pool itself is trivially destructible, so a slot released after this
+    // has run is still handled, by freeing it directly.
+    struct reaper_t
+    {
+        reaper_t() = default;
+        reaper_t(const reaper_t&) = delete;
+        reaper_t(reaper_t&&) = delete;
+
+        ~reaper_t()
+        {
+            auto& cache = pool();
+
+            while (cache.head != nullptr)
+            {
+                node_t* node = cache.head;
+                cache.head = node->next;
+                ::operator delete(node, slot_alignment);
+            }
+
+            cache.count = 0;
+            cache.retired = true;
+        }
+
+        reaper_t& operator=(const reaper_t&) = delete;
+        reaper_t& operator=(reaper_t&&) = delete;
+    };
+
+public:
+    using value_type = T;
+
+    template <typename... Args>
+        requires(std::is_constructible_v<T, Args...>)
+    explicit boxed_t(Args&&... args)
+    {
+        void* memory = acquire();
+
+        try
+        {
+            m_pointer = ::new (memory) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            release(memory);
+            throw;
+        }
+    }
+
+    boxed_t(const boxed_t& that)
+        requires(std::is_copy_constructible_v<T>)
+    {
+        if (that.m_pointer != nullptr)
+        {
+            boxed_t copy(*that.m_pointer);
+            std::swap(m_pointer, copy.m_pointer);
+        }
+    }
+
+    boxed_t(boxed_t&& that) noexcept
+        : m_pointer(std::exchange(that.m_pointer, nullptr))
+    {}
+
+    ~boxed_t()
+    {
+        reset();
+    }
+
+    boxed_t& operator=(const boxed_t& that)
+        requires(std::is_copy_constructible_v<T>)
+    {
+        if (this != std::addressof(that))
+        {
+            boxed_t copy(that);
+            std::swap(m_pointer, copy.m_pointer);
+        }
+
+        return *this;
+    }
+
+    boxed_t& operator=(boxed_t&& that) noexcept
+    {
+        if (this != std::addressof(that))
+        {
+            reset();
+            m_pointer = std::exchange(that.m_pointer, nullptr);
+        }
+
+        return *this;
+    }
+
+    [[nodiscard]] T* get() const noexcept
+    {
+        return m_pointer;
+    }
+
+    T& operator*() const noexcept
+    {
+        return *m_pointer;
+    }
+
+    T* operator->() const noexcept
+    {
+        return m_pointer;
+    }
+
+private:
+    static pool_t& pool() noexcept
+    {
+        thread_local pool_t cache{nullptr, 0, false};
+        return cache;
+    }
+
+    [[gnu::cold, gnu::noinline]] static void* acquire()
+    {
+        auto& cache = pool();
+
+        if (cache.head == nullptr)
+        {
+            return ::operator new(slot_size, slot_alignment);
+        }
+
+        node_t* node = cache.head;
+        cache.head = node->next;
+        cache.count -= 1;
+
+        return node;
+    }
+
+    [[gnu::cold, gnu::noinline]] static void release(void* memory) noexcept
+    {
+        thread_local reaper_t reaper;
+        auto& cache = pool();
+
+        if (cache.retired || cache.count == pool_capacity)
+        {
+            ::operator delete(memory, slot_alignment);
+            return;
+        }
+
+        cache.head = ::new (memory) node_t{cache.head};
+        cache.count += 1;
+    }
+
+    void reset() noexcept
+    {
+        if (m_pointer != nullptr)
+        {
+            std::destroy_at(m_pointer);
+            release(std::exchange(m_pointer, nullptr));
+        }
+    }
+
+    T* m_pointer = nullptr;
+};
+
+/// A result_t whose error lives out of line.
+template <typename Value, typename Error>
+using cold_result_t = result_t<Value, boxed_t<Error>>;
+
+#endif  // BOXED_HPP
@@ -0,0 +1,215 @@
+#ifndef CANCELLATION_HPP
+#define CANCELLATION_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "result.hpp"
+
+#include <sys/eventfd.h>
+
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+#include <tuple>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+class cancel_token_t;
+
+// Signals cancellation to every operation waiting on one of its tokens. The
+// flag is a lock-free atomic checked before each attempt; the eventfd is
+// what wakes operations already blocked in poll. It is written once and
+// never drained, so every present and future waiter sees it.
+class cancel_source_t
+{
+public:
+    cancel_source_t()
+        : m_event(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    {}
+
+    cancel_source_t(const cancel_source_t&) = delete;
+    cancel_source_t(cancel_source_t&&) = delete;
+
+    ~cancel_source_t()
+    {
+        if (m_event != -1)
+        {
+            ::close(m_event);
+        }
+    }
+
+    cancel_source_t& operator=(const cancel_source_t&) = delete;
+    cancel_source_t& operator=(cancel_source_t&&) = delete;
+
+    void cancel() noexcept
+    {
+        if (!m_cancelled.exchange(true, std::memory_order_acq_rel))
+        {
+            std::uint64_t one = 1;
+            std::ignore = ::write(m_event, &one, sizeof(one));
+        }
+    }
+
+    [[nodiscard]] bool cancelled() const noexcept
+    {
+        return m_cancelled.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] int descriptor() const noexcept
+    {
+        return m_event;
+    }
+
+    [[nodiscard]] cancel_token_t token() const noexcept;
+    [[nodiscard]] cancel_token_t token(std::chrono::steady_clock::time_point deadline) const noexcept;
+    [[nodiscard]] cancel_token_t token(std::chrono::steady_clock::duration timeout) const noexcept;
+
+private:
+    std::atomic<bool> m_cancelled{false};
+    int m_event;
+};
+
+// What a blocking operation checks to know when to give up: an optional
+// cancel_source_t, which must outlive the token, and an optional deadline.
+// Waits fail with std::errc::operation_canceled once the source is
+// cancelled and with std::errc::timed_out once the deadline passes. A
+// default token never gives up.
+class cancel_token_t
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    cancel_token_t() noexcept = default;
+
+    explicit cancel_token_t(const cancel_source_t& source, clock_type::time_point deadline = clock_type::time_point::max()) noexcept
+        : m_source(&source)
+        , m_deadline(deadline)
+    {}
+
+    explicit cancel_token_t(clock_type::time_point deadline) noexcept
+        : m_deadline(deadline)
+    {}
+
+    [[nodiscard]] static cancel_token_t after(clock_type::duration timeout) noexcept
+    {
+        return cancel_token_t(clock_type::now() + timeout);
+    }
+
+    [[nodiscard]] bool cancelled() const noexcept
+    {
+        return m_source != nullptr && m_source->cancelled();
+    }
+
+    [[nodiscard]] bool expired() const noexcept
+    {
+        return m_deadline != clock_type::time_point::max() && clock_type::now() >= m_deadline;
+    }
+
+    [[nodiscard]] clock_type::time_point deadline() const noexcept
+    {
+        return m_deadline;
+    }
+
+    /// Blocks until descriptor reports one of events, retrying interrupted
+    /// waits with the time that is left.
+    [[nodiscard]] result_t<void, std::errc> wait(int descriptor, short events) const
+    {
+        pollfd descriptors[2] = {{descriptor, events, 0}, {-1, POLLIN, 0}};
+        nfds_t count = 1;
+
+        if (m_source != nullptr)
+        {
+            descriptors[1].fd = m_source->descriptor();
+            count = 2;
+        }
+
+        for (;;)
+        {
+            if (cancelled())
+            {
+                return fail_t<std::errc>(std::errc::operation_canceled);
+            }
+
+            timespec remaining{};
+            timespec* timeout = nullptr;
+
+            if (m_deadline != clock_type::time_point::max())
+            {
+                auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(m_deadline - clock_type::now());
+
+                if (left <= std::chrono::nanoseconds::zero())
+                {
+                    return fail_t<std::errc>(std::errc::timed_out);
+                }
+
+                remaining.tv_sec = static_cast<time_t>(left.count() / 1'000'000'000);
+                remaining.tv_nsec = static_cast<long>(left.count() % 1'000'000'000);
+                timeout = &remaining;
+            }
+
+            int ready = ::ppoll(descriptors, count, timeout, nullptr);
+
+            if (ready == -1 && errno != EINTR)
+            {
+                return fail_t<std::errc>(static_cast<std::errc>(errno));
+            }
+
+            if (ready > 0 && descriptors[0].revents != 0 && !cancelled())
+            {
+                return {};
+            }
+        }
+    }
+
+    /// Sleeps until time, failing like wait() if the token fires first.
+    [[nodiscard]] result_t<void, std::errc> sleep_until(clock_type::time_point time) const
+    {
+        cancel_token_t bounded(*this);
+        bounded.m_deadline = std::min(time, m_deadline);
+
+        auto slept = bounded.wait(-1, 0);
+
+        if (slept.error() == std::errc::timed_out && time < m_deadline)
+        {
+            return {};
+        }
+
+        return fail_t<std::errc>(slept.error());
+    }
+
+private:
+    const cancel_source_t* m_source = nullptr;
+    clock_type::time_point m_deadline = clock_type::time_point::max();
+};
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+inline cancel_token_t cancel_source_t::token() const noexcept
+{
+    return cancel_token_t(*this);
+}
+
+inline cancel_token_t cancel_source_t::token(std::chrono::steady_clock::time_point deadline) const noexcept
+{
+    return cancel_token_t(*this, deadline);
+}
+
+inline cancel_token_t cancel_source_t::token(std::chrono::steady_clock::duration timeout) const noexcept
+{
+    return cancel_token_t(*this, std::chrono::steady_clock::now() + timeout);
+}
+
+#endif  // CANCELLATION_HPP
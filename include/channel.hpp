@@ -0,0 +1,435 @@
+#ifndef CHANNEL_HPP
+#define CHANNEL_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "cpu.hpp"
+#include "socket.hpp"
+
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// A bidirectional byte channel over a shared memfd mapping: two
+// single-producer/single-consumer rings, one per direction. Each endpoint
+// writes one ring and reads the other, spinning briefly before sleeping on a
+// process-shared futex. The descriptor can be passed to another process
+// (fork or SCM_RIGHTS) and attached there with the opposite side. Results
+// follow socket_t: recv yields 0 bytes once the peer has closed and the ring
+// is drained, send fails with std::errc::broken_pipe.
+//
+// Like a duplicated socket descriptor, destroying an endpoint only unmaps
+// it; close() is what signals end of stream to the peer.
+class channel_t
+{
+    static constexpr std::size_t cache_line = 64;
+    static constexpr int spin_limit = 4096;
+
+    struct ring_t
+    {
+        alignas(cache_line) std::atomic<uint64_t> head;
+        alignas(cache_line) std::atomic<uint64_t> tail;
+        alignas(cache_line) std::atomic<uint32_t> readers_waiting;
+        std::atomic<uint32_t> writers_waiting;
+        std::atomic<uint32_t> closed;
+    };
+
+    struct layout_t
+    {
+        uint64_t capacity;
+        ring_t rings[2];
+    };
+
+    static constexpr std::size_t data_offset = (sizeof(layout_t) + cache_line - 1) / cache_line * cache_line;
+
+public:
+    [[nodiscard]] static result_t<std::pair<channel_t, channel_t>, std::errc> pair(std::size_t capacity)
+    {
+        capacity = std::bit_ceil(std::max<std::size_t>(capacity, cache_line));
+
+        int descriptor = ::memfd_create("channel", MFD_CLOEXEC);
+
+        if (descriptor == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        if (::ftruncate(descriptor, static_cast<off_t>(data_offset + 2 * capacity)) == -1)
+        {
+            auto error = last_error();
+            ::close(descriptor);
+
+            return fail_t<std::errc>(error);
+        }
+
+        channel_t first(descriptor, 0);
+
+        if (first.m_layout == nullptr)
+        {
+            return fail_t<std::errc>(first.m_error);
+        }
+
+        auto* layout = std::construct_at(first.m_layout);
+
+        layout->capacity = capacity;
+        first.m_capacity = capacity;
+
+        auto second = attach(descriptor, 1);
+
+        if (!second)
+        {
+            return fail_t<std::errc>(second.error());
+        }
+
+        return success_t<std::pair<channel_t, channel_t>>(std::move(first), std::move(*second));
+    }
+
+    [[nodiscard]] static result_t<channel_t, std::errc> attach(int descriptor, std::size_t side)
+    {
+        int duplicate = ::fcntl(descriptor, F_DUPFD_CLOEXEC, 0);
+
+        if (duplicate == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        channel_t channel(duplicate, side & 1U);
+
+        if (channel.m_layout == nullptr)
+        {
+            return fail_t<std::errc>(channel.m_error);
+        }
+
+        // The rings mask positions with the capacity, so it has to be the
+        // power of two pair() stored and the file has to be sized for it.
+        if (channel.m_layout->capacity != channel.m_capacity || !std::has_single_bit(channel.m_capacity))
+        {
+            return fail_t<std::errc>(std::errc::invalid_argument);
+        }
+
+        return success_t<channel_t>(std::move(channel));
+    }
+
+    channel_t(channel_t&& that) noexcept
+        : m_descriptor(std::exchange(that.m_descriptor, -1))
+        , m_side(that.m_side)
+        , m_layout(std::exchange(that.m_layout, nullptr))
+        , m_capacity(that.m_capacity)
+        , m_size(that.m_size)
+    {}
+
+    channel_t& operator=(channel_t&& that) noexcept
+    {
+        if (this != std::addressof(that))
+        {
+            release();
+
+            m_descriptor = std::exchange(that.m_descriptor, -1);
+            m_side = that.m_side;
+            m_layout = std::exchange(that.m_layout, nullptr);
+            m_capacity = that.m_capacity;
+            m_size = that.m_size;
+        }
+
+        return *this;
+    }
+
+    ~channel_t()
+    {
+        release();
+    }
+
+    channel_t(const channel_t& /* that */) = delete;
+    channel_t& operator=(const channel_t& /* that */) = delete;
+
+    [[nodiscard]] int descriptor() const noexcept
+    {
+        return m_descriptor;
+    }
+
+    [[nodiscard]] std::size_t side() const noexcept
+    {
+        return m_side;
+    }
+
+    void close()
+    {
+        if (m_layout != nullptr)
+        {
+            for (auto& ring : m_layout->rings)
+            {
+                ring.closed.store(1, std::memory_order_seq_cst);
+
+                wake(ring.readers_waiting);
+                wake(ring.writers_waiting);
+            }
+        }
+
+        release();
+    }
+
+    [[nodiscard]] io_result_t send(std::string_view message) const
+    {
+        return send(message.data(), message.length());
+    }
+
+    [[nodiscard]] io_result_t send(const void* data, std::size_t length) const
+    {
+        auto& ring = outbound();
+
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        uint64_t tail = 0;
+
+        for (int spins = 0;; ++spins)
+        {
+            if (ring.closed.load(std::memory_order_relaxed) != 0)
+            {
+                return fail_t<std::errc>(std::errc::broken_pipe);
+            }
+
+            tail = ring.tail.load(std::memory_order_acquire);
+
+            if (head - tail < m_capacity || length == 0)
+            {
+                break;
+            }
+
+            if (spins < spin_budget())
+            {
+                cpu_t::relax();
+                continue;
+            }
+
+            ring.writers_waiting.store(1, std::memory_order_seq_cst);
+
+            if (ring.tail.load(std::memory_order_seq_cst) == tail && ring.closed.load(std::memory_order_seq_cst) == 0)
+            {
+                wait(ring.writers_waiting);
+            }
+            else
+            {
+                ring.writers_waiting.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t count = std::min(length, static_cast<std::size_t>(m_capacity - (head - tail)));
+
+        copy_in(buffer(m_side), head, static_cast<const std::byte*>(data), count);
+
+        ring.head.store(head + count, std::memory_order_seq_cst);
+
+        if (ring.readers_waiting.load(std::memory_order_seq_cst) != 0 && ring.readers_waiting.exchange(0) != 0)
+        {
+            wake(ring.readers_waiting);
+        }
+
+        return success_t<std::size_t>(count);
+    }
+
+    [[nodiscard]] io_result_t recv(void* data, std::size_t length) const
+    {
+        auto& ring = inbound();
+
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        uint64_t head = 0;
+
+        for (int spins = 0;; ++spins)
+        {
+            head = ring.head.load(std::memory_order_acquire);
+
+            if (head != tail)
+            {
+                break;
+            }
+
+            if (ring.closed.load(std::memory_order_acquire) != 0)
+            {
+                // The peer may have sent its last bytes just before closing.
+                head = ring.head.load(std::memory_order_acquire);
+
+                if (head == tail)
+                {
+                    return success_t<std::size_t>(std::size_t{0});
+                }
+
+                break;
+            }
+
+            if (spins < spin_budget())
+            {
+                cpu_t::relax();
+                continue;
+            }
+
+            ring.readers_waiting.store(1, std::memory_order_seq_cst);
+
+            if (ring.head.load(std::memory_order_seq_cst) == tail && ring.closed.load(std::memory_order_seq_cst) == 0)
+            {
+                wait(ring.readers_waiting);
+            }
+            else
+            {
+                ring.readers_waiting.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::size_t count = std::min(length, static_cast<std::size_t>(head - tail));
+
+        copy_out(buffer(m_side ^ 1U), tail, static_cast<std::byte*>(data), count);
+
+        ring.tail.store(tail + count, std::memory_order_seq_cst);
+
+        if (ring.writers_waiting.load(std::memory_order_seq_cst) != 0 && ring.writers_waiting.exchange(0) != 0)
+        {
+            wake(ring.writers_waiting);
+        }
+
+        return success_t<std::size_t>(count);
+    }
+
+private:
+    channel_t(int descriptor, std::size_t side)
+        : m_descriptor(descriptor)
+        , m_side(side)
+    {
+        struct stat status
+        {};
+
+        if (::fstat(descriptor, &status) == -1)
+        {
+            m_error = last_error();
+            release();
+
+            return;
+        }
+
+        if (static_cast<std::size_t>(status.st_size) < data_offset)
+        {
+            m_error = std::errc::invalid_argument;
+            release();
+
+            return;
+        }
+
+        m_size = static_cast<std::size_t>(status.st_size);
+
+        void* address = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+
+        if (address == MAP_FAILED)
+        {
+            m_error = last_error();
+            release();
+
+            return;
+        }
+
+        m_layout = static_cast<layout_t*>(address);
+        m_capacity = (m_size - data_offset) / 2;
+    }
+
+    void release() noexcept
+    {
+        if (m_layout != nullptr)
+        {
+            ::munmap(m_layout, m_size);
+            m_layout = nullptr;
+        }
+
+        if (m_descriptor != -1)
+        {
+            ::close(m_descriptor);
+            m_descriptor = -1;
+        }
+    }
+
+    [[nodiscard]] ring_t& outbound() const noexcept
+    {
+        return m_layout->rings[m_side];
+    }
+
+    [[nodiscard]] ring_t& inbound() const noexcept
+    {
+        return m_layout->rings[m_side ^ 1U];
+    }
+
+    [[nodiscard]] std::byte* buffer(std::size_t ring) const noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<std::byte*>(m_layout) + data_offset + ring * m_capacity;
+    }
+
+    void copy_in(std::byte* ring, uint64_t position, const std::byte* data, std::size_t count) const noexcept
+    {
+        auto offset = static_cast<std::size_t>(position & (m_capacity - 1));
+        auto first = std::min(count, m_capacity - offset);
+
+        std::memcpy(ring + offset, data, first);
+        std::memcpy(ring, data + first, count - first);
+    }
+
+    void copy_out(const std::byte* ring, uint64_t position, std::byte* data, std::size_t count) const noexcept
+    {
+        auto offset = static_cast<std::size_t>(position & (m_capacity - 1));
+        auto first = std::min(count, m_capacity - offset);
+
+        std::memcpy(data, ring + offset, first);
+        std::memcpy(data + first, ring, count - first);
+    }
+
+    static std::errc last_error() noexcept
+    {
+        return static_cast<std::errc>(errno);
+    }
+
+    // Spinning only pays off when the peer can run concurrently.
+    static int spin_budget() noexcept
+    {
+        static const int budget = std::thread::hardware_concurrency() > 1 ? spin_limit : 0;
+        return budget;
+    }
+
+    static void wait(std::atomic<uint32_t>& word) noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, 1, nullptr, nullptr, 0);
+    }
+
+    static void wake(std::atomic<uint32_t>& word) noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+
+    int m_descriptor;
+    std::size_t m_side;
+    layout_t* m_layout = nullptr;
+    std::size_t m_capacity = 0;
+    std::size_t m_size = 0;
+    std::errc m_error{};
+};
+
+#endif  // CHANNEL_HPP
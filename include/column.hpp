@@ -0,0 +1,619 @@
+#ifndef COLUMN_HPP
+#define COLUMN_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "cpu.hpp"
+#include "maybe.hpp"
+#include "parallel.hpp"
+
+/// \cond
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if CPU_X86_DISPATCH
+    #include <immintrin.h>
+#endif  // CPU_X86_DISPATCH
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+#if CPU_X86_DISPATCH
+
+struct column_avx2_t
+{
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t word_bits = 64;
+    static constexpr std::size_t lanes = 4;
+
+    CPU_TARGET("avx2")
+    static __m256i lane_mask(word_type bits) noexcept
+    {
+        const __m256i select = _mm256_setr_epi64x(1, 2, 4, 8);
+        __m256i broadcast = _mm256_set1_epi64x(static_cast<long long>(bits));
+
+        return _mm256_cmpeq_epi64(_mm256_and_si256(broadcast, select), select);
+    }
+
+    CPU_TARGET("avx2")
+    static double sum(const double* values, const word_type* words, std::size_t count) noexcept
+    {
+        __m256d acc = _mm256_setzero_pd();
+
+        for (std::size_t word = 0; word < count / word_bits; ++word)
+        {
+            const double* base = values + word * word_bits;
+
+            for (std::size_t i = 0; i < word_bits; i += lanes)
+            {
+                __m256d mask = _mm256_castsi256_pd(lane_mask(words[word] >> i));
+                acc = _mm256_add_pd(acc, _mm256_and_pd(_mm256_loadu_pd(base + i), mask));
+            }
+        }
+
+        __m128d half = _mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+
+    CPU_TARGET("avx2")
+    static std::int64_t sum(const std::int64_t* values, const word_type* words, std::size_t count) noexcept
+    {
+        __m256i acc = _mm256_setzero_si256();
+
+        for (std::size_t word = 0; word < count / word_bits; ++word)
+        {
+            const std::int64_t* base = values + word * word_bits;
+
+            for (std::size_t i = 0; i < word_bits; i += lanes)
+            {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                __m256i item = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + i));
+                acc = _mm256_add_epi64(acc, _mm256_and_si256(item, lane_mask(words[word] >> i)));
+            }
+        }
+
+        __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        return _mm_cvtsi128_si64(_mm_add_epi64(half, _mm_unpackhi_epi64(half, half)));
+    }
+
+    template <bool Max>
+    CPU_TARGET("avx2")
+    static double extreme(const double* values, const word_type* words, std::size_t count, double identity) noexcept
+    {
+        const __m256d blank = _mm256_set1_pd(identity);
+        __m256d acc = blank;
+
+        for (std::size_t word = 0; word < count / word_bits; ++word)
+        {
+            const double* base = values + word * word_bits;
+
+            for (std::size_t i = 0; i < word_bits; i += lanes)
+            {
+                __m256d mask = _mm256_castsi256_pd(lane_mask(words[word] >> i));
+                __m256d item = _mm256_blendv_pd(blank, _mm256_loadu_pd(base + i), mask);
+
+                acc = Max ? _mm256_max_pd(acc, item) : _mm256_min_pd(acc, item);
+            }
+        }
+
+        alignas(32) double lane[lanes];
+        _mm256_store_pd(lane, acc);
+
+        return Max ? std::max({lane[0], lane[1], lane[2], lane[3]})
+                   : std::min({lane[0], lane[1], lane[2], lane[3]});
+    }
+
+    template <bool Max>
+    CPU_TARGET("avx2")
+    static std::int64_t extreme(const std::int64_t* values, const word_type* words, std::size_t count, std::int64_t identity) noexcept
+    {
+        const __m256i blank = _mm256_set1_epi64x(identity);
+        __m256i acc = blank;
+
+        for (std::size_t word = 0; word < count / word_bits; ++word)
+        {
+            const std::int64_t* base = values + word * word_bits;
+
+            for (std::size_t i = 0; i < word_bits; i += lanes)
+            {
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                __m256i item = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base + i));
+                item = _mm256_blendv_epi8(blank, item, lane_mask(words[word] >> i));
+
+                __m256i replace = Max ? _mm256_cmpgt_epi64(item, acc) : _mm256_cmpgt_epi64(acc, item);
+                acc = _mm256_blendv_epi8(acc, item, replace);
+            }
+        }
+
+        alignas(32) std::int64_t lane[lanes];
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane), acc);
+
+        return Max ? std::max({lane[0], lane[1], lane[2], lane[3]})
+                   : std::min({lane[0], lane[1], lane[2], lane[3]});
+    }
+
+    CPU_TARGET("avx2")
+    static void fill(double* values, const word_type* words, std::size_t count, double value) noexcept
+    {
+        const __m256d blank = _mm256_set1_pd(value);
+
+        for (std::size_t word = 0; word < count / word_bits; ++word)
+        {
+            double* base = values + word * word_bits;
+
+            for (std::size_t i = 0; i < word_bits; i += lanes)
+            {
+                __m256d mask = _mm256_castsi256_pd(lane_mask(words[word] >> i));
+                _mm256_storeu_pd(base + i, _mm256_blendv_pd(blank, _mm256_loadu_pd(base + i), mask));
+            }
+        }
+    }
+
+    CPU_TARGET("avx2")
+    static void fill(std::int64_t* values, const word_type* words, std::size_t count, std::int64_t value) noexcept
+    {
+        const __m256i blank = _mm256_set1_epi64x(value);
+
+        for (std::size_t word = 0; word < count / word_bits; ++word)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            auto* base = reinterpret_cast<__m256i*>(values + word * word_bits);
+
+            for (std::size_t i = 0; i < word_bits / lanes; ++i)
+            {
+                __m256i item = _mm256_loadu_si256(base + i);
+                _mm256_storeu_si256(base + i, _mm256_blendv_epi8(blank, item, lane_mask(words[word] >> (i * lanes))));
+            }
+        }
+    }
+
+    CPU_TARGET("popcnt")
+    static std::size_t count(const word_type* words, std::size_t length) noexcept
+    {
+        std::size_t result = 0;
+
+        for (std::size_t word = 0; word < length; ++word)
+        {
+            result += static_cast<std::size_t>(__builtin_popcountll(words[word]));
+        }
+
+        return result;
+    }
+};
+
+#endif  // CPU_X86_DISPATCH
+
+template <typename T>
+class column_t
+{
+    static_assert(std::is_arithmetic_v<T>);
+
+public:
+    using value_type = T;
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t word_bits = 64;
+
+    column_t() = default;
+
+    explicit column_t(std::size_t size)
+        : m_values(size)
+        , m_validity(words_for(size))
+        , m_size(size)
+    {}
+
+    explicit column_t(const std::vector<maybe_t<T>>& items)
+        : column_t(items.size())
+    {
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            if (items[i].has_value())
+            {
+                this->set(i, *items[i]);
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<maybe_t<T>> to_maybe() const
+    {
+        std::vector<maybe_t<T>> items;
+        items.reserve(m_size);
+
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            if (this->has_value(i))
+            {
+                items.emplace_back(m_values[i]);
+            }
+            else
+            {
+                items.emplace_back(utils::nothing);
+            }
+        }
+
+        return items;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] const value_type* values() const noexcept
+    {
+        return m_values.data();
+    }
+
+    [[nodiscard]] const word_type* validity() const noexcept
+    {
+        return m_validity.data();
+    }
+
+    [[nodiscard]] bool has_value(std::size_t index) const noexcept
+    {
+        return (m_validity[index / word_bits] >> (index % word_bits)) & 1U;
+    }
+
+    maybe_t<T> operator[](std::size_t index) const
+    {
+        if (this->has_value(index))
+        {
+            return m_values[index];
+        }
+
+        return utils::nothing;
+    }
+
+    void set(std::size_t index, value_type value) noexcept
+    {
+        m_values[index] = value;
+        m_validity[index / word_bits] |= word_type{1} << (index % word_bits);
+    }
+
+    void reset(std::size_t index) noexcept
+    {
+        m_values[index] = value_type{};
+        m_validity[index / word_bits] &= ~(word_type{1} << (index % word_bits));
+    }
+
+    void push_back(value_type value)
+    {
+        this->grow();
+        this->set(m_size - 1, value);
+    }
+
+    void push_back(utils::nothing_t /* unused */)
+    {
+        this->grow();
+    }
+
+    void push_back(const maybe_t<T>& item)
+    {
+        this->grow();
+
+        if (item.has_value())
+        {
+            this->set(m_size - 1, *item);
+        }
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept
+    {
+        return count_range(m_validity.data(), m_validity.size());
+    }
+
+    [[nodiscard]] std::size_t count(utils::parallel_t /* unused */) const
+    {
+        return this->reduce(std::size_t{0}, std::plus<>{}, [](const T* /* values */, const word_type* words, std::size_t length) {
+            return count_range(words, words_for(length));
+        });
+    }
+
+    [[nodiscard]] value_type sum() const noexcept
+    {
+        return sum_range(m_values.data(), m_validity.data(), m_size);
+    }
+
+    [[nodiscard]] value_type sum(utils::parallel_t /* unused */) const
+    {
+        return this->reduce(value_type{}, std::plus<value_type>{}, &sum_range);
+    }
+
+    [[nodiscard]] maybe_t<T> min() const noexcept
+    {
+        return this->present(extreme_range<false>(m_values.data(), m_validity.data(), m_size));
+    }
+
+    [[nodiscard]] maybe_t<T> min(utils::parallel_t /* unused */) const
+    {
+        return this->present(this->reduce(identity<false>(), min_of, &extreme_range<false>));
+    }
+
+    [[nodiscard]] maybe_t<T> max() const noexcept
+    {
+        return this->present(extreme_range<true>(m_values.data(), m_validity.data(), m_size));
+    }
+
+    [[nodiscard]] maybe_t<T> max(utils::parallel_t /* unused */) const
+    {
+        return this->present(this->reduce(identity<true>(), max_of, &extreme_range<true>));
+    }
+
+    template <typename F>
+    [[nodiscard]] std::vector<T> filter(F&& pred) const
+    {
+        std::vector<T> result;
+        result.reserve(this->count());
+
+        filter_range(m_values.data(), m_validity.data(), m_size, pred, result);
+
+        return result;
+    }
+
+    template <typename F>
+    [[nodiscard]] std::vector<T> filter(utils::parallel_t /* unused */, F&& pred) const
+    {
+        std::vector<std::vector<T>> partials(chunk_count(m_size, parallel_grain));
+
+        for_each_chunk(m_size, parallel_grain, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            filter_range(m_values.data() + begin, m_validity.data() + begin / word_bits, end - begin, pred, partials[chunk]);
+        });
+
+        std::size_t total = 0;
+
+        for (const auto& partial : partials)
+        {
+            total += partial.size();
+        }
+
+        std::vector<T> result;
+        result.reserve(total);
+
+        for (const auto& partial : partials)
+        {
+            result.insert(result.end(), partial.begin(), partial.end());
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] std::vector<T> filter() const
+    {
+        return this->filter([](const T& /* unused */) { return true; });
+    }
+
+    void fill_nothing(value_type value) noexcept
+    {
+        fill_range(m_values.data(), m_validity.data(), m_size, value);
+    }
+
+    void fill_nothing(utils::parallel_t /* unused */, value_type value)
+    {
+        for_each_chunk(m_size, parallel_grain, [&](std::size_t /* chunk */, std::size_t begin, std::size_t end) {
+            fill_range(m_values.data() + begin, m_validity.data() + begin / word_bits, end - begin, value);
+        });
+    }
+
+private:
+    static constexpr std::size_t parallel_grain = std::size_t{1} << 16;
+
+    static constexpr bool has_avx2_kernel = std::is_same_v<T, double> || std::is_same_v<T, std::int64_t>;
+
+    static constexpr std::size_t words_for(std::size_t size) noexcept
+    {
+        return (size + word_bits - 1) / word_bits;
+    }
+
+    static constexpr word_type tail_mask(std::size_t size) noexcept
+    {
+        std::size_t bits = size % word_bits;
+        return bits == 0 ? ~word_type{0} : (word_type{1} << bits) - 1;
+    }
+
+    static constexpr bool bit(const word_type* words, std::size_t index) noexcept
+    {
+        return (words[index / word_bits] >> (index % word_bits)) & 1U;
+    }
+
+    template <bool Max>
+    static constexpr value_type identity() noexcept
+    {
+        using limits = std::numeric_limits<value_type>;
+
+        if constexpr (limits::has_infinity)
+        {
+            return Max ? -limits::infinity() : limits::infinity();
+        }
+        else
+        {
+            return Max ? limits::lowest() : limits::max();
+        }
+    }
+
+    static constexpr value_type min_of(value_type lhs, value_type rhs) noexcept
+    {
+        return std::min(lhs, rhs);
+    }
+
+    static constexpr value_type max_of(value_type lhs, value_type rhs) noexcept
+    {
+        return std::max(lhs, rhs);
+    }
+
+    static std::size_t count_range(const word_type* words, std::size_t length) noexcept
+    {
+#if CPU_X86_DISPATCH
+        if (cpu_t::popcnt())
+        {
+            return column_avx2_t::count(words, length);
+        }
+#endif  // CPU_X86_DISPATCH
+
+        std::size_t result = 0;
+
+        for (std::size_t word = 0; word < length; ++word)
+        {
+            result += static_cast<std::size_t>(std::popcount(words[word]));
+        }
+
+        return result;
+    }
+
+    static value_type sum_range(const value_type* values, const word_type* words, std::size_t count) noexcept
+    {
+        value_type result{};
+        std::size_t first = 0;
+
+#if CPU_X86_DISPATCH
+        if constexpr (has_avx2_kernel)
+        {
+            if (cpu_t::avx2())
+            {
+                result = column_avx2_t::sum(values, words, count);
+                first = count / word_bits * word_bits;
+            }
+        }
+#endif  // CPU_X86_DISPATCH
+
+        for (std::size_t i = first; i < count; ++i)
+        {
+            result = static_cast<value_type>(result + (bit(words, i) ? values[i] : value_type{}));
+        }
+
+        return result;
+    }
+
+    template <bool Max>
+    static value_type extreme_range(const value_type* values, const word_type* words, std::size_t count) noexcept
+    {
+        value_type result = identity<Max>();
+        std::size_t first = 0;
+
+#if CPU_X86_DISPATCH
+        if constexpr (has_avx2_kernel)
+        {
+            if (cpu_t::avx2())
+            {
+                result = column_avx2_t::extreme<Max>(values, words, count, result);
+                first = count / word_bits * word_bits;
+            }
+        }
+#endif  // CPU_X86_DISPATCH
+
+        for (std::size_t i = first; i < count; ++i)
+        {
+            value_type item = bit(words, i) ? values[i] : identity<Max>();
+            result = Max ? max_of(result, item) : min_of(result, item);
+        }
+
+        return result;
+    }
+
+    static void fill_range(value_type* values, word_type* words, std::size_t count, value_type value) noexcept
+    {
+        std::size_t first = 0;
+
+#if CPU_X86_DISPATCH
+        if constexpr (has_avx2_kernel)
+        {
+            if (cpu_t::avx2())
+            {
+                column_avx2_t::fill(values, words, count, value);
+                first = count / word_bits * word_bits;
+            }
+        }
+#endif  // CPU_X86_DISPATCH
+
+        for (std::size_t i = first; i < count; ++i)
+        {
+            values[i] = bit(words, i) ? values[i] : value;
+        }
+
+        std::fill_n(words, count / word_bits, ~word_type{0});
+
+        if (count % word_bits != 0)
+        {
+            words[count / word_bits] |= tail_mask(count);
+        }
+    }
+
+    template <typename F>
+    static void filter_range(const value_type* values, const word_type* words, std::size_t count, F& pred, std::vector<T>& result)
+    {
+        for (std::size_t word = 0; word < words_for(count); ++word)
+        {
+            for (word_type bits = words[word]; bits != 0; bits &= bits - 1)
+            {
+                const value_type& item = values[word * word_bits + static_cast<std::size_t>(std::countr_zero(bits))];
+
+                if (std::invoke(pred, item))
+                {
+                    result.push_back(item);
+                }
+            }
+        }
+    }
+
+    template <typename R, typename Combine, typename Kernel>
+    R reduce(R init, Combine combine, Kernel kernel) const
+    {
+        std::vector<R> partials(chunk_count(m_size, parallel_grain), init);
+
+        for_each_chunk(m_size, parallel_grain, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            partials[chunk] = kernel(m_values.data() + begin, m_validity.data() + begin / word_bits, end - begin);
+        });
+
+        R result = init;
+
+        for (const R& partial : partials)
+        {
+            result = combine(result, partial);
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] maybe_t<T> present(value_type result) const noexcept
+    {
+        if (this->count() == 0)
+        {
+            return utils::nothing;
+        }
+
+        return result;
+    }
+
+    void grow()
+    {
+        m_values.emplace_back();
+
+        if (m_size % word_bits == 0)
+        {
+            m_validity.push_back(0);
+        }
+
+        m_size += 1;
+    }
+
+    std::vector<value_type> m_values;
+    std::vector<word_type> m_validity;
+    std::size_t m_size = 0;
+};
+
+#endif  // COLUMN_HPP
@@ -0,0 +1,824 @@
+#ifndef CONCURRENT_MAP_HPP
+#define CONCURRENT_MAP_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "cpu.hpp"
+#include "maybe.hpp"
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+
+#if CPU_X86_DISPATCH && defined(__SSE2__)
+    #include <emmintrin.h>
+#endif  // CPU_X86_DISPATCH && __SSE2__
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+namespace swiss
+{
+    using control_t = std::int8_t;
+
+    inline constexpr control_t empty = -128;
+    inline constexpr control_t deleted = -2;
+    inline constexpr std::size_t group_width = 16;
+    inline constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+}  // namespace swiss
+
+/// Charges every entry its in-place size; pass a weigher of your own to
+/// account for memory the key or value owns.
+struct entry_size_t
+{
+    template <typename Key, typename Value>
+    std::size_t operator()(const Key& /* key */, const Value& /* value */) const noexcept
+    {
+        return sizeof(Key) + sizeof(Value);
+    }
+};
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+namespace swiss
+{
+    /// Spreads a hash over all 64 bits, since std::hash is the identity for
+    /// integers and the table takes its tag and position from different bits.
+    inline std::uint64_t mix(std::uint64_t hash) noexcept
+    {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+
+        return hash;
+    }
+
+    /// Bit i is set when control byte i of the group equals tag.
+    inline std::uint32_t match(const control_t* group, control_t tag) noexcept
+    {
+#if CPU_X86_DISPATCH && defined(__SSE2__)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(tag))));
+#else
+        std::uint32_t bits = 0;
+
+        for (std::size_t i = 0; i < group_width; ++i)
+        {
+            bits |= static_cast<std::uint32_t>(group[i] == tag) << i;
+        }
+
+        return bits;
+#endif  // CPU_X86_DISPATCH && __SSE2__
+    }
+
+    /// Bit i is set when slot i of the group is empty or deleted.
+    inline std::uint32_t match_free(const control_t* group) noexcept
+    {
+#if CPU_X86_DISPATCH && defined(__SSE2__)
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+#else
+        std::uint32_t bits = 0;
+
+        for (std::size_t i = 0; i < group_width; ++i)
+        {
+            bits |= static_cast<std::uint32_t>(group[i] < 0) << i;
+        }
+
+        return bits;
+#endif  // CPU_X86_DISPATCH && __SSE2__
+    }
+}  // namespace swiss
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// A reader-writer lock in one word: a writer bit, a waiter bit and the
+// reader count. Taking it shared or exclusive without contention is a
+// single compare-and-swap; blocked threads park on the word with
+// std::atomic::wait, and releases only notify when the waiter bit says
+// someone is parked. Satisfies SharedLockable for std::shared_lock.
+class rw_lock_t
+{
+    static constexpr std::uint32_t writer = 1U << 31;
+    static constexpr std::uint32_t waiting = 1U << 30;
+    static constexpr std::uint32_t readers = waiting - 1;
+
+public:
+    void lock_shared() noexcept
+    {
+        std::uint32_t state = m_state.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            if ((state & writer) == 0)
+            {
+                if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return;
+                }
+
+                continue;
+            }
+
+            park(state);
+        }
+    }
+
+    void unlock_shared() noexcept
+    {
+        std::uint32_t state = m_state.fetch_sub(1, std::memory_order_release) - 1;
+
+        if ((state & readers) == 0 && (state & waiting) != 0)
+        {
+            m_state.notify_all();
+        }
+    }
+
+    void lock() noexcept
+    {
+        std::uint32_t state = m_state.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            if ((state & writer) == 0)
+            {
+                if (m_state.compare_exchange_weak(state, state | writer, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    break;
+                }
+
+                continue;
+            }
+
+            park(state);
+        }
+
+        for (state = m_state.load(std::memory_order_acquire); (state & readers) != 0; state = m_state.load(std::memory_order_acquire))
+        {
+            park(state);
+        }
+    }
+
+    void unlock() noexcept
+    {
+        if ((m_state.exchange(0, std::memory_order_release) & waiting) != 0)
+        {
+            m_state.notify_all();
+        }
+    }
+
+private:
+    // Sets the waiter bit and sleeps until the word changes from state;
+    // returns early with state refreshed if it already has.
+    void park(std::uint32_t& state) noexcept
+    {
+        if ((state & waiting) == 0 && !m_state.compare_exchange_weak(state, state | waiting, std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        m_state.wait(state | waiting, std::memory_order_relaxed);
+        state = m_state.load(std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint32_t> m_state{0};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Weigher>
+class concurrent_map_t;
+
+// An open-addressing hash table in the style of Abseil's Swiss tables. One
+// control byte per slot holds seven bits of the hash (or marks the slot
+// empty or deleted), and a lookup compares a whole group of sixteen control
+// bytes against the tag with one SIMD instruction before touching any key.
+// The control array repeats its first group past the end, so a group can be
+// loaded at any position without wrapping.
+//
+// Not thread-safe; concurrent_map_t shards it behind locks.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class swiss_table_t
+{
+    struct slot_t
+    {
+        template <typename K, typename... Args>
+        explicit slot_t(K&& k, Args&&... args)
+            : key(std::forward<K>(k))
+            , value(std::forward<Args>(args)...)
+        {}
+
+        Key key;
+        Value value;
+    };
+
+    template <typename, typename, typename, typename, typename>
+    friend class concurrent_map_t;
+
+    static constexpr std::size_t min_capacity = swiss::group_width;
+
+public:
+    swiss_table_t() = default;
+
+    swiss_table_t(const swiss_table_t&) = delete;
+    swiss_table_t(swiss_table_t&&) = delete;
+
+    ~swiss_table_t()
+    {
+        clear();
+        release(m_control, m_slots, m_capacity);
+    }
+
+    swiss_table_t& operator=(const swiss_table_t&) = delete;
+    swiss_table_t& operator=(swiss_table_t&&) = delete;
+
+    [[nodiscard]] maybe_t<Value&> find(const Key& key) noexcept
+    {
+        std::size_t index = find_index(key, hash_of(key));
+
+        if (index == swiss::npos)
+        {
+            return utils::nothing;
+        }
+
+        return m_slots[index].value;
+    }
+
+    [[nodiscard]] maybe_t<const Value&> find(const Key& key) const noexcept
+    {
+        std::size_t index = find_index(key, hash_of(key));
+
+        if (index == swiss::npos)
+        {
+            return utils::nothing;
+        }
+
+        return m_slots[index].value;
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const noexcept
+    {
+        return find_index(key, hash_of(key)) != swiss::npos;
+    }
+
+    /// Inserts a value built from args unless the key is present; returns
+    /// the value in the table and whether it was inserted.
+    template <typename... Args>
+    std::pair<Value&, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        auto [index, inserted] = emplace_index(key, hash_of(key), std::forward<Args>(args)...);
+        return {m_slots[index].value, inserted};
+    }
+
+    template <typename V>
+    bool insert_or_assign(const Key& key, V&& value)
+    {
+        auto [index, inserted] = emplace_index(key, hash_of(key), std::forward<V>(value));
+
+        if (!inserted)
+        {
+            m_slots[index].value = std::forward<V>(value);
+        }
+
+        return inserted;
+    }
+
+    bool erase(const Key& key)
+    {
+        std::size_t index = find_index(key, hash_of(key));
+
+        if (index == swiss::npos)
+        {
+            return false;
+        }
+
+        erase_at(index);
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        for (std::size_t i = 0; i < m_capacity; ++i)
+        {
+            if (occupied(i))
+            {
+                std::destroy_at(m_slots + i);
+            }
+        }
+
+        if (m_capacity != 0)
+        {
+            std::fill_n(m_control, m_capacity + swiss::group_width, swiss::empty);
+        }
+
+        m_size = 0;
+        m_deleted = 0;
+    }
+
+    template <typename F>
+    void for_each(F&& fn)
+    {
+        for (std::size_t i = 0; i < m_capacity; ++i)
+        {
+            if (occupied(i))
+            {
+                std::invoke(fn, std::as_const(m_slots[i].key), m_slots[i].value);
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+private:
+    [[nodiscard]] std::uint64_t hash_of(const Key& key) const noexcept
+    {
+        return swiss::mix(static_cast<std::uint64_t>(m_hash(key)));
+    }
+
+    [[nodiscard]] static swiss::control_t tag(std::uint64_t hash) noexcept
+    {
+        return static_cast<swiss::control_t>(hash & 0x7f);
+    }
+
+    [[nodiscard]] bool occupied(std::size_t index) const noexcept
+    {
+        return m_control[index] >= 0;
+    }
+
+    [[nodiscard]] std::size_t find_index(const Key& key, std::uint64_t hash) const noexcept
+    {
+        if (m_capacity == 0)
+        {
+            return swiss::npos;
+        }
+
+        std::size_t mask = m_capacity - 1;
+        std::size_t position = static_cast<std::size_t>(hash >> 7) & mask;
+
+        for (std::size_t step = 0;; step += swiss::group_width)
+        {
+            position = (position + step) & mask;
+
+            const swiss::control_t* group = m_control + position;
+
+            for (std::uint32_t bits = swiss::match(group, tag(hash)); bits != 0; bits &= bits - 1)
+            {
+                std::size_t index = (position + static_cast<std::size_t>(std::countr_zero(bits))) & mask;
+
+                if (m_equal(m_slots[index].key, key))
+                {
+                    return index;
+                }
+            }
+
+            if (swiss::match(group, swiss::empty) != 0)
+            {
+                return swiss::npos;
+            }
+        }
+    }
+
+    [[nodiscard]] static std::size_t free_index(const swiss::control_t* control, std::size_t capacity, std::uint64_t hash) noexcept
+    {
+        std::size_t mask = capacity - 1;
+        std::size_t position = static_cast<std::size_t>(hash >> 7) & mask;
+
+        for (std::size_t step = 0;; step += swiss::group_width)
+        {
+            position = (position + step) & mask;
+
+            std::uint32_t bits = swiss::match_free(control + position);
+
+            if (bits != 0)
+            {
+                return (position + static_cast<std::size_t>(std::countr_zero(bits))) & mask;
+            }
+        }
+    }
+
+    static void set_control(swiss::control_t* control, std::size_t capacity, std::size_t index, swiss::control_t value) noexcept
+    {
+        control[index] = value;
+
+        if (index < swiss::group_width)
+        {
+            control[capacity + index] = value;
+        }
+    }
+
+    template <typename K, typename... Args>
+    std::pair<std::size_t, bool> emplace_index(K&& key, std::uint64_t hash, Args&&... args)
+    {
+        std::size_t index = find_index(key, hash);
+
+        if (index != swiss::npos)
+        {
+            return {index, false};
+        }
+
+        if ((m_size + m_deleted + 1) * 8 > m_capacity * 7)
+        {
+            grow();
+        }
+
+        index = free_index(m_control, m_capacity, hash);
+
+        std::construct_at(m_slots + index, std::forward<K>(key), std::forward<Args>(args)...);
+
+        if (m_control[index] == swiss::deleted)
+        {
+            m_deleted -= 1;
+        }
+
+        set_control(m_control, m_capacity, index, tag(hash));
+        m_size += 1;
+
+        return {index, true};
+    }
+
+    void erase_at(std::size_t index) noexcept
+    {
+        std::destroy_at(m_slots + index);
+        set_control(m_control, m_capacity, index, swiss::deleted);
+
+        m_size -= 1;
+        m_deleted += 1;
+    }
+
+    // Doubles the table, or rebuilds it at the same size when tombstones
+    // rather than live entries are what filled it up.
+    void grow()
+    {
+        std::size_t capacity = m_capacity == 0 ? min_capacity : m_capacity;
+
+        if ((m_size + 1) * 16 > capacity * 7)
+        {
+            capacity *= 2;
+        }
+
+        auto* control = std::allocator<swiss::control_t>().allocate(capacity + swiss::group_width);
+        auto* slots = std::allocator<slot_t>().allocate(capacity);
+
+        std::fill_n(control, capacity + swiss::group_width, swiss::empty);
+
+        for (std::size_t i = 0; i < m_capacity; ++i)
+        {
+            if (occupied(i))
+            {
+                std::uint64_t hash = hash_of(m_slots[i].key);
+                std::size_t index = free_index(control, capacity, hash);
+
+                std::construct_at(slots + index, std::move(m_slots[i]));
+                std::destroy_at(m_slots + i);
+                set_control(control, capacity, index, tag(hash));
+            }
+        }
+
+        release(m_control, m_slots, m_capacity);
+
+        m_control = control;
+        m_slots = slots;
+        m_capacity = capacity;
+        m_deleted = 0;
+    }
+
+    static void release(swiss::control_t* control, slot_t* slots, std::size_t capacity) noexcept
+    {
+        if (capacity != 0)
+        {
+            std::allocator<swiss::control_t>().deallocate(control, capacity + swiss::group_width);
+            std::allocator<slot_t>().deallocate(slots, capacity);
+        }
+    }
+
+    swiss::control_t* m_control = nullptr;
+    slot_t* m_slots = nullptr;
+    std::size_t m_capacity = 0;
+    std::size_t m_size = 0;
+    std::size_t m_deleted = 0;
+
+    [[no_unique_address]] Hash m_hash;
+    [[no_unique_address]] Equal m_equal;
+};
+
+// A hash map for many threads, split into swiss_table_t shards behind
+// their own rw_lock_t, chosen by the top bits of the hash. Lookups take the
+// shard's lock shared and copy the value out, so find() returns maybe_t<V>;
+// visit() and update() run a callback on the value in place instead.
+//
+// With a byte budget the map becomes a cache: each shard owns an equal part
+// of the budget, entries are charged by the Weigher, and inserting past the
+// budget evicts with the CLOCK algorithm. A lookup sets the entry's
+// reference bit, and the clock hand gives referenced entries a second
+// chance before evicting them.
+template <typename Key,
+          typename Value,
+          typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>,
+          typename Weigher = entry_size_t>
+class concurrent_map_t
+{
+    struct entry_t
+    {
+        template <typename... Args>
+        explicit entry_t(Args&&... args)
+            : value(std::forward<Args>(args)...)
+        {}
+
+        entry_t(entry_t&& that) noexcept(std::is_nothrow_move_constructible_v<Value>)
+            : value(std::move(that.value))
+            , bytes(that.bytes)
+            , referenced(that.referenced.load(std::memory_order_relaxed))
+        {}
+
+        entry_t(const entry_t&) = delete;
+
+        ~entry_t() = default;
+
+        entry_t& operator=(const entry_t&) = delete;
+        entry_t& operator=(entry_t&&) = delete;
+
+        Value value;
+        std::size_t bytes = 0;
+        mutable std::atomic<bool> referenced{false};
+    };
+
+    using table_type = swiss_table_t<Key, entry_t, Hash, Equal>;
+
+    struct alignas(64) shard_t
+    {
+        mutable rw_lock_t mutex;
+        table_type table;
+        std::size_t bytes = 0;
+        std::size_t hand = 0;
+    };
+
+public:
+    static constexpr std::size_t default_shards = 64;
+
+    explicit concurrent_map_t(std::size_t byte_budget = 0, std::size_t shard_count = default_shards)
+        : m_shard_count(std::bit_ceil(std::max<std::size_t>(shard_count, 1)))
+        , m_shard_bits(static_cast<unsigned>(std::countr_zero(m_shard_count)))
+        , m_shard_budget(byte_budget == 0 ? 0 : std::max<std::size_t>(byte_budget / m_shard_count, 1))
+        , m_shards(std::make_unique<shard_t[]>(m_shard_count))
+    {}
+
+    concurrent_map_t(const concurrent_map_t&) = delete;
+    concurrent_map_t(concurrent_map_t&&) = delete;
+
+    ~concurrent_map_t() = default;
+
+    concurrent_map_t& operator=(const concurrent_map_t&) = delete;
+    concurrent_map_t& operator=(concurrent_map_t&&) = delete;
+
+    [[nodiscard]] maybe_t<Value> find(const Key& key) const
+    {
+        maybe_t<Value> result = utils::nothing;
+
+        this->visit(key, [&result](const Value& value) {
+            result = value;
+        });
+
+        return result;
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const
+    {
+        return this->visit(key, [](const Value& /* value */) {});
+    }
+
+    /// Runs fn on the value under the shard's shared lock.
+    template <typename F>
+    bool visit(const Key& key, F&& fn) const
+    {
+        std::uint64_t hash = hash_of(key);
+        const shard_t& shard = shard_of(hash);
+
+        std::shared_lock<rw_lock_t> lock(shard.mutex);
+        std::size_t index = shard.table.find_index(key, hash);
+
+        if (index == swiss::npos)
+        {
+            return false;
+        }
+
+        const entry_t& entry = shard.table.m_slots[index].value;
+
+        if (m_shard_budget != 0 && !entry.referenced.load(std::memory_order_relaxed))
+        {
+            entry.referenced.store(true, std::memory_order_relaxed);
+        }
+
+        std::invoke(std::forward<F>(fn), std::as_const(entry.value));
+
+        return true;
+    }
+
+    /// Runs fn on the value under the shard's exclusive lock.
+    template <typename F>
+    bool update(const Key& key, F&& fn)
+    {
+        std::uint64_t hash = hash_of(key);
+        shard_t& shard = shard_of(hash);
+
+        std::unique_lock<rw_lock_t> lock(shard.mutex);
+        std::size_t index = shard.table.find_index(key, hash);
+
+        if (index == swiss::npos)
+        {
+            return false;
+        }
+
+        auto& slot = shard.table.m_slots[index];
+
+        std::invoke(std::forward<F>(fn), slot.value.value);
+        slot.value.referenced.store(true, std::memory_order_relaxed);
+        charge(shard, slot.key, slot.value);
+        evict(shard, index);
+
+        return true;
+    }
+
+    template <typename... Args>
+    bool try_emplace(const Key& key, Args&&... args)
+    {
+        std::uint64_t hash = hash_of(key);
+        shard_t& shard = shard_of(hash);
+
+        std::unique_lock<rw_lock_t> lock(shard.mutex);
+        auto [index, inserted] = shard.table.emplace_index(key, hash, std::forward<Args>(args)...);
+
+        if (inserted)
+        {
+            auto& slot = shard.table.m_slots[index];
+
+            charge(shard, slot.key, slot.value);
+            evict(shard, index);
+        }
+
+        return inserted;
+    }
+
+    template <typename V>
+    bool insert_or_assign(const Key& key, V&& value)
+    {
+        std::uint64_t hash = hash_of(key);
+        shard_t& shard = shard_of(hash);
+
+        std::unique_lock<rw_lock_t> lock(shard.mutex);
+        auto [index, inserted] = shard.table.emplace_index(key, hash, std::forward<V>(value));
+        auto& slot = shard.table.m_slots[index];
+
+        if (!inserted)
+        {
+            slot.value.value = std::forward<V>(value);
+        }
+
+        charge(shard, slot.key, slot.value);
+        evict(shard, index);
+
+        return inserted;
+    }
+
+    bool erase(const Key& key)
+    {
+        std::uint64_t hash = hash_of(key);
+        shard_t& shard = shard_of(hash);
+
+        std::unique_lock<rw_lock_t> lock(shard.mutex);
+        std::size_t index = shard.table.find_index(key, hash);
+
+        if (index == swiss::npos)
+        {
+            return false;
+        }
+
+        shard.bytes -= shard.table.m_slots[index].value.bytes;
+        shard.table.erase_at(index);
+
+        return true;
+    }
+
+    /// Sum over the shards, each read under its own lock, so it is exact
+    /// only while no other thread is writing.
+    [[nodiscard]] std::size_t size() const
+    {
+        std::size_t total = 0;
+
+        for (std::size_t i = 0; i < m_shard_count; ++i)
+        {
+            std::shared_lock<rw_lock_t> lock(m_shards[i].mutex);
+            total += m_shards[i].table.size();
+        }
+
+        return total;
+    }
+
+    /// Bytes charged by the Weigher, summed like size().
+    [[nodiscard]] std::size_t bytes() const
+    {
+        std::size_t total = 0;
+
+        for (std::size_t i = 0; i < m_shard_count; ++i)
+        {
+            std::shared_lock<rw_lock_t> lock(m_shards[i].mutex);
+            total += m_shards[i].bytes;
+        }
+
+        return total;
+    }
+
+private:
+    [[nodiscard]] std::uint64_t hash_of(const Key& key) const noexcept
+    {
+        return swiss::mix(static_cast<std::uint64_t>(m_hash(key)));
+    }
+
+    [[nodiscard]] std::size_t shard_index(std::uint64_t hash) const noexcept
+    {
+        return m_shard_bits == 0 ? 0 : static_cast<std::size_t>(hash >> (64 - m_shard_bits));
+    }
+
+    [[nodiscard]] shard_t& shard_of(std::uint64_t hash) const noexcept
+    {
+        return m_shards[shard_index(hash)];
+    }
+
+    void charge(shard_t& shard, const Key& key, entry_t& entry) const
+    {
+        std::size_t bytes = m_weigher(key, entry.value);
+
+        shard.bytes = shard.bytes - entry.bytes + bytes;
+        entry.bytes = bytes;
+    }
+
+    // Runs the clock hand until the shard is back within its budget. The
+    // entry just written is skipped, so a single oversized entry stays.
+    void evict(shard_t& shard, std::size_t keep)
+    {
+        if (m_shard_budget == 0)
+        {
+            return;
+        }
+
+        auto& table = shard.table;
+
+        for (std::size_t steps = 0; shard.bytes > m_shard_budget && table.size() > 1 && steps < 2 * table.capacity(); ++steps)
+        {
+            std::size_t index = shard.hand++ & (table.capacity() - 1);
+
+            if (index == keep || !table.occupied(index))
+            {
+                continue;
+            }
+
+            entry_t& entry = table.m_slots[index].value;
+
+            if (entry.referenced.exchange(false, std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            shard.bytes -= entry.bytes;
+            table.erase_at(index);
+        }
+    }
+
+    std::size_t m_shard_count;
+    unsigned m_shard_bits;
+    std::size_t m_shard_budget;
+    std::unique_ptr<shard_t[]> m_shards;  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays, modernize-avoid-c-arrays)
+
+    [[no_unique_address]] Hash m_hash;
+    [[no_unique_address]] Weigher m_weigher;
+};
+
+#endif  // CONCURRENT_MAP_HPP
@@ -0,0 +1,110 @@
+#ifndef CPU_HPP
+#define CPU_HPP
+
+/*****************************************************************************/
+/*** MACRO DEFINITIONS *******************************************************/
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define CPU_X86_DISPATCH 1
+    #define CPU_TARGET(isa)  __attribute__((target(isa)))
+#else
+    #define CPU_X86_DISPATCH 0
+    #define CPU_TARGET(isa)
+#endif
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#if CPU_X86_DISPATCH
+    #include <cpuid.h>
+#endif
+
+/// \cond
+#include <cstdint>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+struct cpu_t
+{
+    static bool avx2() noexcept
+    {
+#if CPU_X86_DISPATCH
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    static bool sse42() noexcept
+    {
+#if CPU_X86_DISPATCH
+        static const bool supported = __builtin_cpu_supports("sse4.2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    static bool popcnt() noexcept
+    {
+#if CPU_X86_DISPATCH
+        static const bool supported = __builtin_cpu_supports("popcnt");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    static bool pclmul() noexcept
+    {
+#if CPU_X86_DISPATCH
+        static const bool supported = __builtin_cpu_supports("pclmul");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    /// Whether the time-stamp counter ticks at a constant rate across
+    /// frequency changes and deep sleep states, so it can serve as a clock.
+    static bool invariant_tsc() noexcept
+    {
+#if CPU_X86_DISPATCH
+        static const bool supported = []() {
+            unsigned int eax = 0;
+            unsigned int ebx = 0;
+            unsigned int ecx = 0;
+            unsigned int edx = 0;
+
+            return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1U << 8)) != 0;
+        }();
+
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    /// Reads the time-stamp counter, or returns 0 where there is none.
+    static std::uint64_t timestamp() noexcept
+    {
+#if CPU_X86_DISPATCH
+        return __builtin_ia32_rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    static void relax() noexcept
+    {
+#if CPU_X86_DISPATCH
+        __builtin_ia32_pause();
+#endif
+    }
+};
+
+#endif  // CPU_HPP
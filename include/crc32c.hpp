@@ -0,0 +1,282 @@
+#ifndef CRC32C_HPP
+#define CRC32C_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "cpu.hpp"
+
+#include <sys/uio.h>
+
+/// \cond
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#if CPU_X86_DISPATCH && defined(__x86_64__)
+    #include <immintrin.h>
+#endif  // CPU_X86_DISPATCH && __x86_64__
+
+/// \endcond
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+// CRC-32C (Castagnoli) kernels. Each one extends a raw CRC register over a
+// buffer, without the initial and final inversions that crc32c_t applies,
+// so they can be chained and checked against each other.
+namespace crc32c
+{
+    /// The reflected Castagnoli polynomial.
+    inline constexpr std::uint32_t polynomial = 0x82F63B78;
+
+    /// x^exponent modulo the polynomial, in the reflected bit order of the
+    /// CRC register.
+    constexpr std::uint32_t power(std::size_t exponent) noexcept
+    {
+        std::uint32_t value = 0x80000000;
+
+        for (std::size_t i = 0; i < exponent; ++i)
+        {
+            value = (value >> 1) ^ ((value & 1U) != 0 ? polynomial : 0U);
+        }
+
+        return value;
+    }
+
+    constexpr std::array<std::array<std::uint32_t, 256>, 8> make_tables() noexcept
+    {
+        std::array<std::array<std::uint32_t, 256>, 8> tables{};
+
+        for (std::uint32_t i = 0; i < 256; ++i)
+        {
+            std::uint32_t crc = i;
+
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ ((crc & 1U) != 0 ? polynomial : 0U);
+            }
+
+            tables[0][i] = crc;
+        }
+
+        for (std::size_t k = 1; k < tables.size(); ++k)
+        {
+            for (std::size_t i = 0; i < 256; ++i)
+            {
+                tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+            }
+        }
+
+        return tables;
+    }
+
+    /// Slicing-by-8 tables: tables[k][b] is the register after byte b
+    /// followed by k zero bytes.
+    inline constexpr auto tables = make_tables();
+
+    inline std::uint64_t load64(const std::byte* data) noexcept
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data, sizeof(word));
+
+        return word;
+    }
+
+    /// Table-driven fallback that folds eight bytes per step.
+    inline std::uint32_t portable(std::uint32_t crc, const std::byte* data, std::size_t length) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            for (; length >= 8; data += 8, length -= 8)
+            {
+                std::uint64_t word = load64(data) ^ crc;
+                auto low = static_cast<std::uint32_t>(word);
+                auto high = static_cast<std::uint32_t>(word >> 32);
+
+                crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24]
+                    ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+            }
+        }
+
+        for (; length != 0; ++data, --length)
+        {
+            crc = (crc >> 8) ^ tables[0][(crc ^ static_cast<std::uint32_t>(*data)) & 0xFF];
+        }
+
+        return crc;
+    }
+
+#if CPU_X86_DISPATCH && defined(__x86_64__)
+    /// One crc32 instruction per eight bytes. Each depends on the last, so
+    /// this runs at the instruction's latency rather than its throughput.
+    CPU_TARGET("sse4.2")
+    inline std::uint32_t sse42(std::uint32_t crc, const std::byte* data, std::size_t length) noexcept
+    {
+        std::uint64_t state = crc;
+
+        for (; length >= 8; data += 8, length -= 8)
+        {
+            state = _mm_crc32_u64(state, load64(data));
+        }
+
+        crc = static_cast<std::uint32_t>(state);
+
+        for (; length != 0; ++data, --length)
+        {
+            crc = _mm_crc32_u8(crc, static_cast<std::uint8_t>(*data));
+        }
+
+        return crc;
+    }
+
+    /// Runs three independent crc32 streams over consecutive Lane-byte
+    /// stretches of each block, then folds the first two forward across the
+    /// stretches after them with carry-less multiplies by x^(8 Lane) and
+    /// x^(16 Lane) and merges everything with one more crc32.
+    template <std::size_t Lane>
+    CPU_TARGET("sse4.2,pclmul")
+    inline std::uint32_t fold3(std::uint32_t crc, const std::byte*& data, std::size_t& length) noexcept
+    {
+        static_assert(Lane % 8 == 0);
+
+        // crc32 of a 64-bit product multiplies by a further x^33.
+        static constexpr std::uint32_t skip_one = power(8 * Lane - 33);
+        static constexpr std::uint32_t skip_two = power(16 * Lane - 33);
+
+        const __m128i one = _mm_cvtsi32_si128(static_cast<int>(skip_one));
+        const __m128i two = _mm_cvtsi32_si128(static_cast<int>(skip_two));
+
+        for (; length >= 3 * Lane; data += 3 * Lane, length -= 3 * Lane)
+        {
+            std::uint64_t first = crc;
+            std::uint64_t second = 0;
+            std::uint64_t third = 0;
+
+            for (std::size_t i = 0; i < Lane; i += 8)
+            {
+                first = _mm_crc32_u64(first, load64(data + i));
+                second = _mm_crc32_u64(second, load64(data + Lane + i));
+                third = _mm_crc32_u64(third, load64(data + 2 * Lane + i));
+            }
+
+            __m128i shifted = _mm_xor_si128(_mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(first)), two, 0x00),
+                                            _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(second)), one, 0x00));
+
+            crc = static_cast<std::uint32_t>(third ^ _mm_crc32_u64(0, static_cast<std::uint64_t>(_mm_cvtsi128_si64(shifted))));
+        }
+
+        return crc;
+    }
+
+    /// Interleaves three crc32 streams to run at the instruction's
+    /// throughput, in large blocks and then small ones, and finishes the
+    /// tail with sse42().
+    CPU_TARGET("sse4.2,pclmul")
+    inline std::uint32_t pclmul(std::uint32_t crc, const std::byte* data, std::size_t length) noexcept
+    {
+        crc = fold3<1024>(crc, data, length);
+        crc = fold3<64>(crc, data, length);
+
+        return sse42(crc, data, length);
+    }
+#endif  // CPU_X86_DISPATCH && __x86_64__
+
+    /// Below this many bytes the interleaved kernel has no full block to
+    /// work on.
+    inline constexpr std::size_t fold_threshold = 3 * 64;
+
+    inline std::uint32_t extend(std::uint32_t crc, const std::byte* data, std::size_t length) noexcept
+    {
+#if CPU_X86_DISPATCH && defined(__x86_64__)
+        if (length >= fold_threshold && cpu_t::pclmul() && cpu_t::sse42())
+        {
+            return pclmul(crc, data, length);
+        }
+
+        if (cpu_t::sse42())
+        {
+            return sse42(crc, data, length);
+        }
+#endif  // CPU_X86_DISPATCH && __x86_64__
+
+        return portable(crc, data, length);
+    }
+}  // namespace crc32c
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// A running CRC-32C, the checksum of iSCSI, ext4 and SCTP, over bytes fed to
+// it piece by piece. Feeding the vectors of a gathered write gives the same
+// value as feeding their concatenation, so a frame can be checksummed from
+// the iovecs it is sent with rather than from a linearized copy.
+//
+// The kernel is picked per call from the CPU: interleaved crc32 streams
+// merged with carry-less multiplies, single-stream crc32 for short input,
+// or a slicing-by-8 table where neither exists.
+class crc32c_t
+{
+public:
+    crc32c_t() noexcept = default;
+
+    /// Continues a checksum whose value() so far is value.
+    explicit crc32c_t(std::uint32_t value) noexcept
+        : m_state(~value)
+    {}
+
+    [[nodiscard]] static std::uint32_t compute(const void* data, std::size_t length) noexcept
+    {
+        return crc32c_t().update(data, length).value();
+    }
+
+    [[nodiscard]] static std::uint32_t compute(std::string_view message) noexcept
+    {
+        return compute(message.data(), message.length());
+    }
+
+    crc32c_t& update(const void* data, std::size_t length) noexcept
+    {
+        m_state = crc32c::extend(m_state, static_cast<const std::byte*>(data), length);
+        return *this;
+    }
+
+    crc32c_t& update(std::string_view message) noexcept
+    {
+        return update(message.data(), message.length());
+    }
+
+    crc32c_t& update(std::span<const std::byte> bytes) noexcept
+    {
+        return update(bytes.data(), bytes.size());
+    }
+
+    crc32c_t& update(std::span<const iovec> vectors) noexcept
+    {
+        for (const auto& vector : vectors)
+        {
+            update(vector.iov_base, vector.iov_len);
+        }
+
+        return *this;
+    }
+
+    void reset() noexcept
+    {
+        m_state = ~std::uint32_t{0};
+    }
+
+    [[nodiscard]] std::uint32_t value() const noexcept
+    {
+        return ~m_state;
+    }
+
+private:
+    std::uint32_t m_state = ~std::uint32_t{0};
+};
+
+#endif  // CRC32C_HPP
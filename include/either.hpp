@@ -42,25 +42,25 @@ public:
     {}
 
     template <typename... Args>
-    void construct(left_t /* unused */, Args&&... args)
+    constexpr void construct(left_t /* unused */, Args&&... args)
     {
-        ::new (std::addressof(this->get(left))) Left(std::forward<Args>(args)...);
+        std::construct_at(std::addressof(this->get(left)), std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void construct(right_t /* unused */, Args&&... args)
+    constexpr void construct(right_t /* unused */, Args&&... args)
     {
-        ::new (std::addressof(this->get(right))) Right(std::forward<Args>(args)...);
+        std::construct_at(std::addressof(this->get(right)), std::forward<Args>(args)...);
     }
 
-    void destruct(left_t /* unused */)
+    constexpr void destruct(left_t /* unused */)
     {
-        this->get(left).~Left();
+        std::destroy_at(std::addressof(this->get(left)));
     }
 
-    void destruct(right_t /* unused */)
+    constexpr void destruct(right_t /* unused */)
     {
-        this->get(right).~Right();
+        std::destroy_at(std::addressof(this->get(right)));
     }
 
     constexpr Left& get(left_t /* unused */) noexcept
@@ -107,7 +107,7 @@ private:
         constexpr storage_t(const storage_t&) = delete;
         constexpr storage_t(storage_t&&) noexcept = delete;
 
-        ~storage_t() {};
+        constexpr ~storage_t() {};
 
         constexpr storage_t& operator=(const storage_t&) = delete;
         constexpr storage_t& operator=(storage_t&&) noexcept = delete;
@@ -145,14 +145,14 @@ public:
     {}
 
     template <typename... Args>
-    void construct(left_t /* unused */, Args&&... args)
+    constexpr void construct(left_t /* unused */, Args&&... args)
     {
-        ::new (std::addressof(this->get(left))) Left(std::forward<Args>(args)...);
+        std::construct_at(std::addressof(this->get(left)), std::forward<Args>(args)...);
     }
 
-    void destruct(left_t /* unused */)
+    constexpr void destruct(left_t /* unused */)
     {
-        this->get(left).~Left();
+        std::destroy_at(std::addressof(this->get(left)));
     }
 
     constexpr Left& get(left_t /* unused */) noexcept
@@ -182,7 +182,7 @@ private:
         constexpr storage_t(const storage_t&) = delete;
         constexpr storage_t(storage_t&&) noexcept = delete;
 
-        ~storage_t() {};
+        constexpr ~storage_t() {};
 
         constexpr storage_t& operator=(const storage_t&) = delete;
         constexpr storage_t& operator=(storage_t&&) noexcept = delete;
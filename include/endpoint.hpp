@@ -0,0 +1,213 @@
+#ifndef ENDPOINT_HPP
+#define ENDPOINT_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "maybe.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// A socket address resolved once up front, so reconnect loops and pools can
+// reuse it without re-parsing.
+class endpoint_t
+{
+public:
+    [[nodiscard]] static maybe_t<endpoint_t> parse(std::string_view addr, uint16_t port)
+    {
+        std::array<char, INET6_ADDRSTRLEN> text{};
+
+        if (addr.size() >= text.size())
+        {
+            return utils::nothing;
+        }
+
+        std::copy(addr.begin(), addr.end(), text.begin());
+
+        endpoint_t endpoint;
+
+        if (addr.find(':') == std::string_view::npos)
+        {
+            auto& socket = endpoint.as<sockaddr_in>();
+
+            socket.sin_family = AF_INET;
+            socket.sin_port = htons(port);
+
+            if (::inet_pton(AF_INET, text.data(), &socket.sin_addr) != 1)
+            {
+                return utils::nothing;
+            }
+
+            endpoint.m_length = sizeof(sockaddr_in);
+        }
+        else
+        {
+            auto& socket = endpoint.as<sockaddr_in6>();
+
+            socket.sin6_family = AF_INET6;
+            socket.sin6_port = htons(port);
+
+            if (::inet_pton(AF_INET6, text.data(), &socket.sin6_addr) != 1)
+            {
+                return utils::nothing;
+            }
+
+            endpoint.m_length = sizeof(sockaddr_in6);
+        }
+
+        return endpoint;
+    }
+
+    [[nodiscard]] static endpoint_t ipv4(uint32_t addr, uint16_t port) noexcept
+    {
+        endpoint_t endpoint;
+        auto& socket = endpoint.as<sockaddr_in>();
+
+        socket.sin_family = AF_INET;
+        socket.sin_port = htons(port);
+        socket.sin_addr.s_addr = htonl(addr);
+
+        endpoint.m_length = sizeof(sockaddr_in);
+
+        return endpoint;
+    }
+
+    [[nodiscard]] static endpoint_t ipv6(const std::array<uint8_t, 16>& addr, uint16_t port) noexcept
+    {
+        endpoint_t endpoint;
+        auto& socket = endpoint.as<sockaddr_in6>();
+
+        socket.sin6_family = AF_INET6;
+        socket.sin6_port = htons(port);
+
+        std::memcpy(&socket.sin6_addr, addr.data(), addr.size());
+
+        endpoint.m_length = sizeof(sockaddr_in6);
+
+        return endpoint;
+    }
+
+    /// The IPv6 wildcard address; bound on a dual-stack socket it accepts
+    /// both IPv4 and IPv6 peers.
+    [[nodiscard]] static endpoint_t any(uint16_t port) noexcept
+    {
+        return ipv6({}, port);
+    }
+
+    /// A Unix domain socket path, or nothing if it does not fit in
+    /// sun_path with its terminator. A path starting with '\0' names an
+    /// abstract socket; its name is exactly the given bytes, with no
+    /// terminator added.
+    [[nodiscard]] static maybe_t<endpoint_t> local(std::string_view path)
+    {
+        endpoint_t endpoint;
+        auto& socket = endpoint.as<sockaddr_un>();
+
+        bool abstract = !path.empty() && path.front() == '\0';
+        std::size_t length = abstract ? path.size() : path.size() + 1;
+
+        if (length > sizeof(socket.sun_path))
+        {
+            return utils::nothing;
+        }
+
+        socket.sun_family = AF_UNIX;
+        std::memcpy(socket.sun_path, path.data(), path.size());
+
+        endpoint.m_length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + length);
+
+        return endpoint;
+    }
+
+    /// An address the kernel filled in, as getsockname or accept do.
+    [[nodiscard]] static endpoint_t from(const sockaddr_storage& storage, socklen_t length) noexcept
+    {
+        endpoint_t endpoint;
+
+        endpoint.m_storage = storage;
+        endpoint.m_length = std::min<socklen_t>(length, sizeof(storage));
+
+        return endpoint;
+    }
+
+    [[nodiscard]] int family() const noexcept
+    {
+        return m_storage.ss_family;
+    }
+
+    [[nodiscard]] uint16_t port() const noexcept
+    {
+        switch (family())
+        {
+        case AF_INET:
+            return ntohs(as<sockaddr_in>().sin_port);
+        case AF_INET6:
+            return ntohs(as<sockaddr_in6>().sin6_port);
+        default:
+            return 0;
+        }
+    }
+
+    /// The same address as seen from a dual-stack IPv6 socket.
+    [[nodiscard]] endpoint_t mapped() const noexcept
+    {
+        if (family() != AF_INET)
+        {
+            return *this;
+        }
+
+        std::array<uint8_t, 16> addr{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+        std::memcpy(addr.data() + 12, &as<sockaddr_in>().sin_addr, 4);
+
+        return ipv6(addr, port());
+    }
+
+    [[nodiscard]] const sockaddr* data() const noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<const sockaddr*>(&m_storage);
+    }
+
+    [[nodiscard]] socklen_t size() const noexcept
+    {
+        return m_length;
+    }
+
+private:
+    endpoint_t() = default;
+
+    template <typename T>
+    T& as() noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return *reinterpret_cast<T*>(&m_storage);
+    }
+
+    template <typename T>
+    const T& as() const noexcept
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return *reinterpret_cast<const T*>(&m_storage);
+    }
+
+    sockaddr_storage m_storage{};
+    socklen_t m_length = 0;
+};
+
+#endif  // ENDPOINT_HPP
@@ -0,0 +1,488 @@
+#ifndef HTTP_HPP
+#define HTTP_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "cpu.hpp"
+#include "maybe.hpp"
+#include "result.hpp"
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#if CPU_X86_DISPATCH
+    #include <immintrin.h>
+#endif  // CPU_X86_DISPATCH
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+enum class http_error_t
+{
+    incomplete,
+    bad_request,
+    head_too_large,
+    body_too_large,
+    too_many_headers,
+    unsupported_version,
+    unsupported_encoding,
+};
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+namespace http
+{
+    /// Case-insensitive comparison for header names.
+    inline bool equals(std::string_view left, std::string_view right) noexcept
+    {
+        auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c; };
+
+        return left.size() == right.size()
+            && std::equal(left.begin(), left.end(), right.begin(), [&](char a, char b) { return lower(a) == lower(b); });
+    }
+}  // namespace http
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Delimiter scanning for request fields. find<true> stops at the first byte
+// that cannot appear in a header value (a control character other than tab,
+// or DEL), find<false> additionally stops at space, which ends the request
+// target. Both return size when no delimiter is found.
+struct http_scan_t
+{
+    template <bool Value>
+    static constexpr bool delimiter(unsigned char c) noexcept
+    {
+        return c == 0x7F || (Value ? (c < 0x20 && c != '\t') : c <= 0x20);
+    }
+
+    template <bool Value>
+    static std::size_t scalar(const char* data, std::size_t size) noexcept
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (delimiter<Value>(static_cast<unsigned char>(data[i])))
+            {
+                return i;
+            }
+        }
+
+        return size;
+    }
+
+#if CPU_X86_DISPATCH
+    template <bool Value>
+    CPU_TARGET("sse4.2")
+    static std::size_t sse42(const char* data, std::size_t size) noexcept
+    {
+        static constexpr int mode = _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT;
+
+        alignas(16) static constexpr char value_ranges[16] = {'\x00', '\x08', '\x0A', '\x1F', '\x7F', '\x7F'};
+        alignas(16) static constexpr char token_ranges[16] = {'\x00', '\x20', '\x7F', '\x7F'};
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const __m128i ranges = _mm_load_si128(reinterpret_cast<const __m128i*>(Value ? value_ranges : token_ranges));
+        const int count = Value ? 6 : 4;
+
+        std::size_t i = 0;
+
+        for (; i + 16 <= size; i += 16)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            int index = _mm_cmpestri(ranges, count, chunk, 16, mode);
+
+            if (index != 16)
+            {
+                return i + static_cast<std::size_t>(index);
+            }
+        }
+
+        return i + scalar<Value>(data + i, size - i);
+    }
+
+    template <bool Value>
+    CPU_TARGET("avx2")
+    static std::size_t avx2(const char* data, std::size_t size) noexcept
+    {
+        const __m256i limit = _mm256_set1_epi8(Value ? 0x1F : 0x20);
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i del = _mm256_set1_epi8(0x7F);
+
+        std::size_t i = 0;
+
+        for (; i + 32 <= size; i += 32)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, limit), limit);
+
+            if constexpr (Value)
+            {
+                control = _mm256_andnot_si256(_mm256_cmpeq_epi8(chunk, tab), control);
+            }
+
+            auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_or_si256(control, _mm256_cmpeq_epi8(chunk, del))));
+
+            if (mask != 0)
+            {
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+
+        return i + sse42<Value>(data + i, size - i);
+    }
+#endif  // CPU_X86_DISPATCH
+
+    template <bool Value>
+    static std::size_t find(const char* data, std::size_t size) noexcept
+    {
+#if CPU_X86_DISPATCH
+        if (cpu_t::avx2())
+        {
+            return avx2<Value>(data, size);
+        }
+
+        if (cpu_t::sse42())
+        {
+            return sse42<Value>(data, size);
+        }
+#endif  // CPU_X86_DISPATCH
+
+        return scalar<Value>(data, size);
+    }
+};
+
+struct http_header_t
+{
+    std::string_view name;
+    std::string_view value;
+};
+
+/// Every view points into the buffer handed to the parser; size is the
+/// number of bytes the request occupies there, head and body included.
+struct http_request_t
+{
+    std::string_view method;
+    std::string_view target;
+    int minor_version;
+    std::span<const http_header_t> headers;
+    std::string_view body;
+    std::size_t size;
+
+    [[nodiscard]] maybe_t<std::string_view> header(std::string_view name) const noexcept
+    {
+        for (const auto& item : headers)
+        {
+            if (http::equals(item.name, name))
+            {
+                return item.value;
+            }
+        }
+
+        return utils::nothing;
+    }
+};
+
+// An incremental HTTP/1.1 request parser that never allocates: headers are
+// stored in a fixed array inside the parser and exposed as views into the
+// caller's buffer. Call parse() with everything received so far; it returns
+// http_error_t::incomplete until a full request is buffered, remembering how
+// far it already searched for the end of the head. Pipelined requests are
+// parsed by advancing the buffer by request.size and calling parse() again.
+// Chunked bodies are rejected with unsupported_encoding.
+template <std::size_t MaxHeaders = 32>
+class http_parser_t
+{
+    static constexpr std::size_t default_max_head = 8 * 1024;
+    static constexpr std::size_t default_max_body = 1024 * 1024;
+
+public:
+    http_parser_t()
+        : http_parser_t(default_max_head, default_max_body)
+    {}
+
+    http_parser_t(std::size_t max_head, std::size_t max_body)
+        : m_max_head(max_head)
+        , m_max_body(max_body)
+    {}
+
+    void reset() noexcept
+    {
+        m_scanned = 0;
+    }
+
+    [[nodiscard]] result_t<http_request_t, http_error_t> parse(std::string_view buffer)
+    {
+        auto window = buffer.substr(0, m_max_head);
+        auto end = head_end(window, m_scanned > 3 ? m_scanned - 3 : 0);
+
+        if (end == std::string_view::npos)
+        {
+            if (buffer.size() >= m_max_head)
+            {
+                return failure(http_error_t::head_too_large);
+            }
+
+            m_scanned = window.size();
+            return fail_t<http_error_t>(http_error_t::incomplete);
+        }
+
+        http_request_t request{};
+
+        auto head = buffer.substr(0, end + 2);
+        std::size_t position = 0;
+
+        if (auto error = parse_request_line(head, position, request); error.has_value())
+        {
+            return failure(*error);
+        }
+
+        std::size_t count = 0;
+
+        while (position < head.size())
+        {
+            if (count == MaxHeaders)
+            {
+                return failure(http_error_t::too_many_headers);
+            }
+
+            if (!parse_header(head, position, m_headers[count]))
+            {
+                return failure(http_error_t::bad_request);
+            }
+
+            ++count;
+        }
+
+        request.headers = std::span<const http_header_t>(m_headers.data(), count);
+
+        std::size_t length = 0;
+        bool has_length = false;
+
+        for (const auto& header : request.headers)
+        {
+            if (http::equals(header.name, "transfer-encoding"))
+            {
+                return failure(http_error_t::unsupported_encoding);
+            }
+
+            if (http::equals(header.name, "content-length"))
+            {
+                auto parsed = parse_length(header.value);
+
+                if (!parsed.has_value() || (has_length && *parsed != length))
+                {
+                    return failure(http_error_t::bad_request);
+                }
+
+                length = *parsed;
+                has_length = true;
+            }
+        }
+
+        if (length > m_max_body)
+        {
+            return failure(http_error_t::body_too_large);
+        }
+
+        std::size_t head_size = end + 4;
+
+        if (buffer.size() - head_size < length)
+        {
+            m_scanned = end;
+            return fail_t<http_error_t>(http_error_t::incomplete);
+        }
+
+        request.body = buffer.substr(head_size, length);
+        request.size = head_size + length;
+
+        m_scanned = 0;
+
+        return success_t<http_request_t>(request);
+    }
+
+private:
+    static constexpr std::array<bool, 256> token_table = [] {
+        std::array<bool, 256> table{};
+
+        for (unsigned char c = '0'; c <= '9'; ++c)
+        {
+            table[c] = true;
+        }
+
+        for (unsigned char c = 'a'; c <= 'z'; ++c)
+        {
+            table[c] = true;
+            table[static_cast<std::size_t>(c - 'a' + 'A')] = true;
+        }
+
+        for (char c : std::string_view("!#$%&'*+-.^_`|~"))
+        {
+            table[static_cast<unsigned char>(c)] = true;
+        }
+
+        return table;
+    }();
+
+    result_t<http_request_t, http_error_t> failure(http_error_t error) noexcept
+    {
+        m_scanned = 0;
+        return fail_t<http_error_t>(error);
+    }
+
+    static std::size_t head_end(std::string_view window, std::size_t position) noexcept
+    {
+        while (position < window.size())
+        {
+            const void* found = std::memchr(window.data() + position, '\r', window.size() - position);
+
+            if (found == nullptr)
+            {
+                break;
+            }
+
+            position = static_cast<std::size_t>(static_cast<const char*>(found) - window.data());
+
+            if (window.substr(position, 4) == "\r\n\r\n")
+            {
+                return position;
+            }
+
+            ++position;
+        }
+
+        return std::string_view::npos;
+    }
+
+    static std::size_t token(std::string_view head, std::size_t position) noexcept
+    {
+        while (position < head.size() && token_table[static_cast<unsigned char>(head[position])])
+        {
+            ++position;
+        }
+
+        return position;
+    }
+
+    static maybe_t<http_error_t> parse_request_line(std::string_view head, std::size_t& position, http_request_t& request) noexcept
+    {
+        static constexpr std::string_view protocol = "HTTP/1.";
+
+        std::size_t method_end = token(head, 0);
+
+        if (method_end == 0 || method_end >= head.size() || head[method_end] != ' ')
+        {
+            return http_error_t::bad_request;
+        }
+
+        std::size_t target_begin = method_end + 1;
+        std::size_t target_end = target_begin + http_scan_t::find<false>(head.data() + target_begin, head.size() - target_begin);
+
+        if (target_end == target_begin || target_end >= head.size() || head[target_end] != ' ')
+        {
+            return http_error_t::bad_request;
+        }
+
+        auto version = head.substr(target_end + 1);
+
+        if (version.size() < protocol.size() + 3 || version.substr(0, 5) != protocol.substr(0, 5))
+        {
+            return http_error_t::bad_request;
+        }
+
+        if (!version.starts_with(protocol) || (version[7] != '0' && version[7] != '1') || version.substr(8, 2) != "\r\n")
+        {
+            return http_error_t::unsupported_version;
+        }
+
+        request.method = head.substr(0, method_end);
+        request.target = head.substr(target_begin, target_end - target_begin);
+        request.minor_version = version[7] - '0';
+
+        position = target_end + 1 + protocol.size() + 3;
+
+        return utils::nothing;
+    }
+
+    static bool parse_header(std::string_view head, std::size_t& position, http_header_t& header) noexcept
+    {
+        std::size_t name_end = token(head, position);
+
+        if (name_end == position || name_end >= head.size() || head[name_end] != ':')
+        {
+            return false;
+        }
+
+        std::size_t value_begin = name_end + 1;
+
+        while (value_begin < head.size() && (head[value_begin] == ' ' || head[value_begin] == '\t'))
+        {
+            ++value_begin;
+        }
+
+        std::size_t value_end = value_begin + http_scan_t::find<true>(head.data() + value_begin, head.size() - value_begin);
+
+        if (value_end + 1 >= head.size() || head[value_end] != '\r' || head[value_end + 1] != '\n')
+        {
+            return false;
+        }
+
+        std::size_t trimmed = value_end;
+
+        while (trimmed > value_begin && (head[trimmed - 1] == ' ' || head[trimmed - 1] == '\t'))
+        {
+            --trimmed;
+        }
+
+        header.name = head.substr(position, name_end - position);
+        header.value = head.substr(value_begin, trimmed - value_begin);
+
+        position = value_end + 2;
+
+        return true;
+    }
+
+    static maybe_t<std::size_t> parse_length(std::string_view value) noexcept
+    {
+        static constexpr std::size_t max_digits = 18;
+
+        if (value.empty() || value.size() > max_digits)
+        {
+            return utils::nothing;
+        }
+
+        std::size_t length = 0;
+
+        for (char c : value)
+        {
+            if (c < '0' || c > '9')
+            {
+                return utils::nothing;
+            }
+
+            length = length * 10 + static_cast<std::size_t>(c - '0');
+        }
+
+        return length;
+    }
+
+    std::array<http_header_t, MaxHeaders> m_headers{};
+    std::size_t m_scanned = 0;
+    std::size_t m_max_head;
+    std::size_t m_max_body;
+};
+
+#endif  // HTTP_HPP
@@ -0,0 +1,274 @@
+#ifndef INPLACE_FUNCTION_HPP
+#define INPLACE_FUNCTION_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+inline constexpr std::size_t inplace_capacity = 4 * sizeof(void*);
+
+template <typename Signature, std::size_t Capacity = inplace_capacity, bool Allocating = false>
+class inplace_function_t;
+
+/// An inplace_function_t that moves callables too large for its buffer to the
+/// heap instead of rejecting them.
+template <typename Signature, std::size_t Capacity = inplace_capacity>
+using unique_function_t = inplace_function_t<Signature, Capacity, true>;
+
+template <typename T>
+inline constexpr bool is_inplace_function_v = false;
+
+template <typename Signature, std::size_t Capacity, bool Allocating>
+inline constexpr bool is_inplace_function_v<inplace_function_t<Signature, Capacity, Allocating>> = true;
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// A move-only type-erased callable that stores its target in a buffer of
+// Capacity bytes inside the object. A callable that does not fit, or needs
+// more than max_align_t alignment, is a compile error, so an
+// inplace_function_t never allocates; unique_function_t lifts that limit by
+// keeping oversized callables on the heap.
+//
+// The invoker is held directly in the object rather than behind a vtable,
+// so a call is one indirect jump. Targets that are trivially copyable, and
+// every heap-stored target, are relocated by copying the buffer and need no
+// manager call when moved.
+template <typename R, typename... Args, std::size_t Capacity, bool Allocating>
+class inplace_function_t<R(Args...), Capacity, Allocating>
+{
+    static_assert(Capacity >= sizeof(void*), "capacity must hold at least a pointer");
+
+    static constexpr std::size_t alignment = alignof(std::max_align_t);
+
+    using invoker_t = R (*)(std::byte*, Args&&...);
+    using destroyer_t = void (*)(std::byte*) noexcept;
+    using relocator_t = void (*)(std::byte*, std::byte*) noexcept;
+
+    template <typename F>
+    static constexpr bool fits_v = sizeof(F) <= Capacity && alignof(F) <= alignment
+                                && std::is_nothrow_move_constructible_v<F>;
+
+    template <typename F>
+    static constexpr bool accepts_v = !is_inplace_function_v<std::decay_t<F>>
+                                   && !std::is_same_v<std::decay_t<F>, std::nullptr_t>
+                                   && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>;
+
+public:
+    using result_type = R;
+
+    static constexpr std::size_t capacity = Capacity;
+
+    /// Whether a callable of type F is stored inside the object.
+    template <typename F>
+    static constexpr bool is_inline_v = fits_v<std::decay_t<F>>;
+
+    inplace_function_t() noexcept = default;
+
+    inplace_function_t(std::nullptr_t) noexcept  // NOLINT(hicpp-explicit-conversions)
+    {}
+
+    template <typename F>
+        requires(accepts_v<F>)
+    inplace_function_t(F&& fn)  // NOLINT(hicpp-explicit-conversions)
+        : inplace_function_t(std::in_place_type<std::decay_t<F>>, std::forward<F>(fn))
+    {}
+
+    template <typename F, typename... Params>
+        requires(std::is_constructible_v<F, Params...> && std::is_invocable_r_v<R, F&, Args...>)
+    explicit inplace_function_t(std::in_place_type_t<F> /*unused*/, Params&&... params)
+    {
+        static_assert(Allocating || fits_v<F>, "callable is too large, over-aligned or throwing on move for the inplace_function_t buffer");
+
+        if constexpr (std::is_pointer_v<F> || std::is_member_pointer_v<F>)
+        {
+            F pointer(std::forward<Params>(params)...);
+
+            if (pointer == nullptr)
+            {
+                return;
+            }
+
+            ::new (static_cast<void*>(m_storage.data())) F(pointer);
+        }
+        else if constexpr (fits_v<F>)
+        {
+            ::new (static_cast<void*>(m_storage.data())) F(std::forward<Params>(params)...);
+        }
+        else
+        {
+            ::new (static_cast<void*>(m_storage.data())) F*(new F(std::forward<Params>(params)...));
+        }
+
+        m_invoke = &invoke<F>;
+        m_destroy = destroyer<F>();
+        m_relocate = relocator<F>();
+    }
+
+    inplace_function_t(const inplace_function_t&) = delete;
+
+    inplace_function_t(inplace_function_t&& that) noexcept
+    {
+        this->take(that);
+    }
+
+    ~inplace_function_t()
+    {
+        this->reset();
+    }
+
+    inplace_function_t& operator=(const inplace_function_t&) = delete;
+
+    inplace_function_t& operator=(inplace_function_t&& that) noexcept
+    {
+        if (this != std::addressof(that))
+        {
+            this->reset();
+            this->take(that);
+        }
+
+        return *this;
+    }
+
+    inplace_function_t& operator=(std::nullptr_t) noexcept
+    {
+        this->reset();
+        return *this;
+    }
+
+    template <typename F>
+        requires(accepts_v<F>)
+    inplace_function_t& operator=(F&& fn)
+    {
+        return *this = inplace_function_t(std::forward<F>(fn));
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_invoke != &invoke_empty;
+    }
+
+    R operator()(Args... args)
+    {
+        return m_invoke(m_storage.data(), std::forward<Args>(args)...);
+    }
+
+private:
+    template <typename F>
+    static F& target(std::byte* storage) noexcept
+    {
+        if constexpr (fits_v<F>)
+        {
+            return *std::launder(reinterpret_cast<F*>(storage));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+        else
+        {
+            return **std::launder(reinterpret_cast<F**>(storage));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+    }
+
+    template <typename F>
+    static R invoke(std::byte* storage, Args&&... args)
+    {
+        if constexpr (std::is_void_v<R>)
+        {
+            std::invoke(target<F>(storage), std::forward<Args>(args)...);
+        }
+        else
+        {
+            return std::invoke(target<F>(storage), std::forward<Args>(args)...);
+        }
+    }
+
+    [[noreturn]] static R invoke_empty(std::byte* /*unused*/, Args&&... /*unused*/)
+    {
+        throw std::bad_function_call();
+    }
+
+    template <typename F>
+    static constexpr destroyer_t destroyer() noexcept
+    {
+        if constexpr (!fits_v<F>)
+        {
+            return [](std::byte* storage) noexcept {
+                delete &target<F>(storage);
+            };
+        }
+        else if constexpr (std::is_trivially_destructible_v<F>)
+        {
+            return nullptr;
+        }
+        else
+        {
+            return [](std::byte* storage) noexcept {
+                std::destroy_at(&target<F>(storage));
+            };
+        }
+    }
+
+    template <typename F>
+    static constexpr relocator_t relocator() noexcept
+    {
+        if constexpr (!fits_v<F> || std::is_trivially_copyable_v<F>)
+        {
+            return nullptr;
+        }
+        else
+        {
+            return [](std::byte* destination, std::byte* source) noexcept {
+                F& from = target<F>(source);
+
+                ::new (static_cast<void*>(destination)) F(std::move(from));
+                std::destroy_at(&from);
+            };
+        }
+    }
+
+    void take(inplace_function_t& that) noexcept
+    {
+        if (that.m_relocate == nullptr)
+        {
+            m_storage = that.m_storage;
+        }
+        else
+        {
+            that.m_relocate(m_storage.data(), that.m_storage.data());
+        }
+
+        m_invoke = std::exchange(that.m_invoke, &invoke_empty);
+        m_destroy = std::exchange(that.m_destroy, nullptr);
+        m_relocate = std::exchange(that.m_relocate, nullptr);
+    }
+
+    void reset() noexcept
+    {
+        if (m_destroy != nullptr)
+        {
+            m_destroy(m_storage.data());
+        }
+
+        m_invoke = &invoke_empty;
+        m_destroy = nullptr;
+        m_relocate = nullptr;
+    }
+
+    alignas(alignment) std::array<std::byte, Capacity> m_storage;
+    invoker_t m_invoke = &invoke_empty;
+    destroyer_t m_destroy = nullptr;
+    relocator_t m_relocate = nullptr;
+};
+
+#endif  // INPLACE_FUNCTION_HPP
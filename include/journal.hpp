@@ -0,0 +1,1171 @@
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "cancellation.hpp"
+#include "crc32c.hpp"
+#include "maybe.hpp"
+#include "result.hpp"
+#include "transport.hpp"
+
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+/// When a frame was appended, on the CLOCK_REALTIME scale.
+using journal_time_t = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+
+struct journal_options_t
+{
+    /// Size of each segment file, allocated in full when it is created.
+    std::size_t segment_size = 64 * 1024 * 1024;
+
+    /// Appended bytes after which an append flushes what is pending to disk;
+    /// 0 leaves flushing to explicit sync() calls.
+    std::size_t sync_bytes = 4 * 1024 * 1024;
+};
+
+struct journal_frame_t
+{
+    journal_time_t time;
+    std::uint32_t stream;
+    std::span<const std::byte> payload;
+
+    /// Whether the payload still matches the checksum taken on append.
+    bool intact;
+};
+
+struct replay_options_t
+{
+    /// Multiple of the recorded pace; 0 sends every frame without pausing.
+    double speed = 1.0;
+
+    /// Only frames of this stream, or every frame.
+    maybe_t<std::uint32_t> stream = utils::nothing;
+};
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+// The on-disk layout. A journal is a directory of segment files named after
+// their zero-padded index. Each segment starts with a segment_header_t and
+// holds 8-byte aligned frames from data_offset on. A writer stores a frame's
+// length and then the reserved commit word as soon as it has the space, and
+// the committed word once the rest is written, so a reader that finds a
+// frame reserved knows how far to step if its writer died. A zero commit
+// word marks space nobody has reserved yet.
+namespace journal
+{
+    inline constexpr std::uint64_t magic = 0x314C4E52554F4A55;  // "UJOURNL1"
+    inline constexpr std::uint32_t committed = 0x314D5246;      // "FRM1"
+    inline constexpr std::uint32_t skipped = 0x50494B53;        // "SKIP"
+    inline constexpr std::uint32_t reserved = 0x44565352;       // "RSVD"
+
+    inline constexpr std::size_t data_offset = 64;
+    inline constexpr std::size_t frame_alignment = 8;
+    inline constexpr std::string_view extension = ".journal";
+    inline constexpr std::string_view lock_name = "journal.lock";
+
+    struct segment_header_t
+    {
+        std::uint64_t magic;
+        std::uint64_t index;
+        std::uint64_t size;
+
+        /// Index of the first segment its writer created; segments before
+        /// it were left by an earlier writer.
+        std::uint64_t origin;
+    };
+
+    struct frame_header_t
+    {
+        std::uint32_t commit;
+        std::uint32_t checksum;
+        std::uint32_t stream;
+        std::uint32_t length;
+        std::int64_t timestamp;
+    };
+
+    static_assert(sizeof(segment_header_t) <= data_offset);
+    static_assert(sizeof(frame_header_t) % frame_alignment == 0);
+
+    inline std::errc last_error() noexcept
+    {
+        return static_cast<std::errc>(errno);
+    }
+
+    constexpr std::size_t frame_size(std::size_t length) noexcept
+    {
+        return (sizeof(frame_header_t) + length + frame_alignment - 1) / frame_alignment * frame_alignment;
+    }
+
+    inline std::size_t page_size() noexcept
+    {
+        static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    inline std::atomic_ref<std::uint32_t> commit_word(const std::byte* frame) noexcept
+    {
+        return std::atomic_ref<std::uint32_t>(*reinterpret_cast<std::uint32_t*>(const_cast<std::byte*>(frame)));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast, cppcoreguidelines-pro-type-const-cast)
+    }
+
+    /// CRC-32C of everything in the frame after the checksum word.
+    inline std::uint32_t checksum(const frame_header_t& header, std::span<const iovec> payload) noexcept
+    {
+        constexpr std::size_t covered = offsetof(frame_header_t, stream);
+
+        crc32c_t crc;
+        crc.update(reinterpret_cast<const std::byte*>(&header) + covered, sizeof(header) - covered);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        return crc.update(payload).value();
+    }
+
+    inline std::filesystem::path segment_path(const std::filesystem::path& directory, std::uint64_t index)
+    {
+        std::string name = std::to_string(index);
+        name.insert(0, 20 - name.size(), '0');
+
+        return directory / name.append(extension);
+    }
+
+    inline maybe_t<std::uint64_t> segment_index(const std::filesystem::path& path)
+    {
+        std::string stem = path.stem().string();
+        std::uint64_t index = 0;
+
+        if (path.extension() != extension)
+        {
+            return utils::nothing;
+        }
+
+        auto [end, error] = std::from_chars(stem.data(), stem.data() + stem.size(), index);
+
+        if (error != std::errc{} || end != stem.data() + stem.size())
+        {
+            return utils::nothing;
+        }
+
+        return index;
+    }
+
+    inline result_t<std::vector<std::uint64_t>, std::errc> list_segments(const std::filesystem::path& directory)
+    {
+        std::vector<std::uint64_t> indices;
+        std::error_code code;
+
+        for (std::filesystem::directory_iterator entry(directory, code), end; !code && entry != end; entry.increment(code))
+        {
+            auto index = segment_index(entry->path());
+
+            if (index.has_value())
+            {
+                indices.push_back(*index);
+            }
+        }
+
+        if (code)
+        {
+            return fail_t<std::errc>(static_cast<std::errc>(code.value()));
+        }
+
+        std::sort(indices.begin(), indices.end());
+
+        return success_t<std::vector<std::uint64_t>>(std::move(indices));
+    }
+
+    // A segment file and its shared mapping.
+    class mapping_t
+    {
+    public:
+        mapping_t() noexcept = default;
+
+        /// Creates a segment with all of its blocks allocated.
+        [[nodiscard]] static result_t<mapping_t, std::errc> create(const std::filesystem::path& path, const segment_header_t& header)
+        {
+            mapping_t mapping;
+            mapping.m_descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+
+            if (mapping.m_descriptor == -1)
+            {
+                return fail_t<std::errc>(last_error());
+            }
+
+            if (int error = ::posix_fallocate(mapping.m_descriptor, 0, static_cast<off_t>(header.size)); error != 0)
+            {
+                ::unlink(path.c_str());
+                return fail_t<std::errc>(static_cast<std::errc>(error));
+            }
+
+            if (auto mapped = mapping.map(header.size, PROT_READ | PROT_WRITE); mapped.has_value())
+            {
+                ::unlink(path.c_str());
+                return fail_t<std::errc>(*mapped);
+            }
+
+            std::memcpy(mapping.m_data, &header, sizeof(header));
+
+            return success_t<mapping_t>(std::move(mapping));
+        }
+
+        /// Maps an existing segment read-only, failing with
+        /// std::errc::invalid_argument unless its header is complete.
+        [[nodiscard]] static result_t<mapping_t, std::errc> open(const std::filesystem::path& path)
+        {
+            mapping_t mapping;
+            mapping.m_descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+            struct stat status
+            {};
+
+            if (mapping.m_descriptor == -1 || ::fstat(mapping.m_descriptor, &status) == -1)
+            {
+                return fail_t<std::errc>(last_error());
+            }
+
+            if (static_cast<std::size_t>(status.st_size) < data_offset)
+            {
+                return fail_t<std::errc>(std::errc::invalid_argument);
+            }
+
+            if (auto mapped = mapping.map(static_cast<std::size_t>(status.st_size), PROT_READ); mapped.has_value())
+            {
+                return fail_t<std::errc>(*mapped);
+            }
+
+            auto header = mapping.header();
+
+            if (header.magic != magic || header.size != mapping.m_size)
+            {
+                return fail_t<std::errc>(std::errc::invalid_argument);
+            }
+
+            return success_t<mapping_t>(std::move(mapping));
+        }
+
+        mapping_t(mapping_t&& that) noexcept
+            : m_descriptor(std::exchange(that.m_descriptor, -1))
+            , m_data(std::exchange(that.m_data, nullptr))
+            , m_size(std::exchange(that.m_size, 0))
+        {}
+
+        mapping_t& operator=(mapping_t&& that) noexcept
+        {
+            if (this != std::addressof(that))
+            {
+                close();
+
+                m_descriptor = std::exchange(that.m_descriptor, -1);
+                m_data = std::exchange(that.m_data, nullptr);
+                m_size = std::exchange(that.m_size, 0);
+            }
+
+            return *this;
+        }
+
+        ~mapping_t()
+        {
+            close();
+        }
+
+        mapping_t(const mapping_t& /* that */) = delete;
+        mapping_t& operator=(const mapping_t& /* that */) = delete;
+
+        [[nodiscard]] bool is_open() const noexcept
+        {
+            return m_data != nullptr;
+        }
+
+        [[nodiscard]] std::byte* data() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] segment_header_t header() const noexcept
+        {
+            segment_header_t header{};
+            std::memcpy(&header, m_data, sizeof(header));
+
+            return header;
+        }
+
+        /// Writes the pages holding [first, last) back to the file.
+        [[nodiscard]] maybe_t<std::errc> flush(std::size_t first, std::size_t last) const noexcept
+        {
+            first = first / page_size() * page_size();
+
+            if (first < last && ::msync(m_data + first, last - first, MS_SYNC) == -1)
+            {
+                return last_error();
+            }
+
+            return utils::nothing;
+        }
+
+        /// Flushes the whole file and releases it.
+        [[nodiscard]] maybe_t<std::errc> retire() noexcept
+        {
+            maybe_t<std::errc> error = flush(0, m_size);
+
+            if (!error.has_value() && ::fdatasync(m_descriptor) == -1)
+            {
+                error = last_error();
+            }
+
+            close();
+
+            return error;
+        }
+
+        void close() noexcept
+        {
+            if (m_data != nullptr)
+            {
+                ::munmap(m_data, m_size);
+                m_data = nullptr;
+            }
+
+            if (m_descriptor != -1)
+            {
+                ::close(m_descriptor);
+                m_descriptor = -1;
+            }
+        }
+
+    private:
+        maybe_t<std::errc> map(std::size_t size, int protection) noexcept
+        {
+            void* address = ::mmap(nullptr, size, protection, MAP_SHARED, m_descriptor, 0);
+
+            if (address == MAP_FAILED)
+            {
+                return last_error();
+            }
+
+            m_data = static_cast<std::byte*>(address);
+            m_size = size;
+
+            return utils::nothing;
+        }
+
+        int m_descriptor = -1;
+        std::byte* m_data = nullptr;
+        std::size_t m_size = 0;
+    };
+}  // namespace journal
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// An append-only log of frames in memory-mapped segment files, for
+// capturing traffic to analyse or replay later. Appends are safe from any
+// number of threads and take no lock: a frame's space is reserved with one
+// fetch_add on the current segment, filled in place and published by
+// storing its commit word. The writer whose reservation crosses the end of
+// a segment marks the rest of it skipped and moves everyone to the next
+// one, which sync() prepares ahead of time so that rollover rarely waits
+// on the file system.
+//
+// Durability is batched: after every sync_bytes appended, the append that
+// crosses the mark msyncs the pages written since the last flush, and
+// segments the writers have left are fdatasynced and unmapped. sync() does
+// the same on demand and reports failures, which batched flushes drop.
+//
+// One journal_t owns a directory at a time, enforced with an advisory lock,
+// and starts a new segment when it opens one that already has segments. The
+// lock file records the next free segment index, so a restarted writer never
+// reuses the index of a spare segment its predecessor unlinked.
+class journal_t
+{
+    struct segment_t
+    {
+        journal::mapping_t mapping;
+        std::uint64_t index;
+
+        /// Offset up to which every frame was committed when last flushed.
+        std::size_t synced = journal::data_offset;
+
+        alignas(64) std::atomic<std::uint64_t> reserved{journal::data_offset};
+        alignas(64) std::atomic<std::uint64_t> committed{journal::data_offset};
+    };
+
+    struct state_t
+    {
+        std::filesystem::path directory;
+        journal_options_t options;
+        std::uint64_t origin = 0;
+        int lock = -1;
+
+        /// Guards segments, spare and the synced offsets; appends only take
+        /// it to roll over.
+        std::mutex mutex;
+        std::vector<std::unique_ptr<segment_t>> segments;
+        std::unique_ptr<segment_t> spare;
+
+        std::atomic<std::errc> error{};
+        alignas(64) std::atomic<segment_t*> current{nullptr};
+        alignas(64) std::atomic<std::size_t> unsynced{0};
+        std::atomic<bool> syncing{false};
+    };
+
+public:
+    [[nodiscard]] static result_t<journal_t, std::errc> create(const std::filesystem::path& directory, journal_options_t options = {})
+    {
+        auto page = journal::page_size();
+        options.segment_size = std::max((options.segment_size + page - 1) / page * page, page);
+
+        std::error_code code;
+        std::filesystem::create_directories(directory, code);
+
+        if (code)
+        {
+            return fail_t<std::errc>(static_cast<std::errc>(code.value()));
+        }
+
+        auto state = std::make_unique<state_t>();
+        state->directory = directory;
+        state->options = options;
+        state->lock = ::open((directory / journal::lock_name).c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+        journal_t created(std::move(state));
+
+        if (created.m_state->lock == -1 || ::flock(created.m_state->lock, LOCK_EX | LOCK_NB) == -1)
+        {
+            return fail_t<std::errc>(journal::last_error());
+        }
+
+        auto existing = journal::list_segments(directory);
+
+        if (!existing)
+        {
+            return fail_t<std::errc>(existing.error());
+        }
+
+        // A spare segment the last writer unlinked may already be mapped by
+        // a reader, so its index is not reused either.
+        std::uint64_t next = 0;
+
+        if (::pread(created.m_state->lock, &next, sizeof(next), 0) != static_cast<ssize_t>(sizeof(next)))
+        {
+            next = 0;
+        }
+
+        created.m_state->origin = std::max(existing->empty() ? 0 : existing->back() + 1, next);
+
+        auto first = created.make_segment(created.m_state->origin);
+
+        if (!first)
+        {
+            return fail_t<std::errc>(first.error());
+        }
+
+        created.m_state->segments.push_back(std::move(*first));
+        created.m_state->current.store(created.m_state->segments.back().get(), std::memory_order_release);
+
+        return success_t<journal_t>(std::move(created));
+    }
+
+    journal_t(journal_t&& that) noexcept = default;
+
+    journal_t& operator=(journal_t&& that) noexcept
+    {
+        if (this != std::addressof(that))
+        {
+            close();
+            m_state = std::move(that.m_state);
+        }
+
+        return *this;
+    }
+
+    ~journal_t()
+    {
+        close();
+    }
+
+    journal_t(const journal_t& /* that */) = delete;
+    journal_t& operator=(const journal_t& /* that */) = delete;
+
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return m_state != nullptr;
+    }
+
+    [[nodiscard]] std::size_t max_frame_length() const noexcept
+    {
+        return m_state != nullptr ? m_state->options.segment_size - journal::data_offset - sizeof(journal::frame_header_t) : 0;
+    }
+
+    [[nodiscard]] result_t<void, std::errc> append(std::uint32_t stream, std::string_view message)
+    {
+        return append(stream, message.data(), message.length());
+    }
+
+    [[nodiscard]] result_t<void, std::errc> append(std::uint32_t stream, const void* data, std::size_t length)
+    {
+        iovec vector{const_cast<void*>(data), length};  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        return append(stream, std::span<const iovec>(&vector, 1));
+    }
+
+    /// Appends the concatenation of vectors as one frame. Fails with
+    /// std::errc::message_size for frames longer than max_frame_length().
+    [[nodiscard]] result_t<void, std::errc> append(std::uint32_t stream, std::span<const iovec> vectors)
+    {
+        if (m_state == nullptr)
+        {
+            return fail_t<std::errc>(std::errc::bad_file_descriptor);
+        }
+
+        std::size_t length = 0;
+
+        for (const auto& vector : vectors)
+        {
+            length += vector.iov_len;
+        }
+
+        if (length > max_frame_length())
+        {
+            return fail_t<std::errc>(std::errc::message_size);
+        }
+
+        std::size_t size = journal::frame_size(length);
+        auto now = std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now());
+
+        journal::frame_header_t header{0, 0, stream, static_cast<std::uint32_t>(length), now.time_since_epoch().count()};
+        header.checksum = journal::checksum(header, vectors);
+
+        segment_t* segment = m_state->current.load(std::memory_order_acquire);
+
+        for (;;)
+        {
+            if (segment == nullptr)
+            {
+                return fail_t<std::errc>(m_state->error.load(std::memory_order_relaxed));
+            }
+
+            std::uint64_t start = segment->reserved.fetch_add(size, std::memory_order_relaxed);
+            std::uint64_t capacity = segment->mapping.size();
+
+            if (start + size <= capacity)
+            {
+                write(*segment, static_cast<std::size_t>(start), header, vectors);
+                break;
+            }
+
+            if (start <= capacity)
+            {
+                roll(*segment, static_cast<std::size_t>(start));
+            }
+
+            m_state->current.wait(segment, std::memory_order_acquire);
+            segment = m_state->current.load(std::memory_order_acquire);
+        }
+
+        auto threshold = m_state->options.sync_bytes;
+
+        if (threshold != 0 && m_state->unsynced.fetch_add(size, std::memory_order_relaxed) + size >= threshold
+            && !m_state->syncing.exchange(true, std::memory_order_acquire))
+        {
+            m_state->unsynced.store(0, std::memory_order_relaxed);
+            std::ignore = sync();
+            m_state->syncing.store(false, std::memory_order_release);
+        }
+
+        return {};
+    }
+
+    /// Flushes every frame appended so far, retires the segments the writers
+    /// have left and prepares the next segment.
+    [[nodiscard]] result_t<void, std::errc> sync()
+    {
+        if (m_state == nullptr)
+        {
+            return fail_t<std::errc>(std::errc::bad_file_descriptor);
+        }
+
+        std::lock_guard lock(m_state->mutex);
+
+        segment_t* current = m_state->current.load(std::memory_order_acquire);
+        std::errc error{};
+
+        for (auto& segment : m_state->segments)
+        {
+            if (!segment->mapping.is_open())
+            {
+                continue;
+            }
+
+            std::size_t capacity = segment->mapping.size();
+            auto end = static_cast<std::size_t>(std::min<std::uint64_t>(segment->reserved.load(std::memory_order_relaxed), capacity));
+
+            bool finished = segment.get() != current && segment->committed.load(std::memory_order_acquire) == capacity;
+            maybe_t<std::errc> failed = finished ? segment->mapping.retire() : segment->mapping.flush(segment->synced, end);
+
+            // Frames still being written are flushed again once they commit,
+            // so the next sync starts from the first of them.
+            if (!finished)
+            {
+                segment->synced = settled(*segment, segment->synced, end);
+            }
+
+            if (failed.has_value() && error == std::errc{})
+            {
+                error = *failed;
+            }
+        }
+
+        if (m_state->spare == nullptr && current != nullptr)
+        {
+            auto spare = make_segment(current->index + 1);
+
+            if (spare)
+            {
+                m_state->spare = std::move(*spare);
+            }
+        }
+
+        if (error != std::errc{})
+        {
+            return fail_t<std::errc>(error);
+        }
+
+        return {};
+    }
+
+    /// Flushes and unmaps every segment and releases the directory. Appends
+    /// must have finished.
+    void close()
+    {
+        if (m_state == nullptr)
+        {
+            return;
+        }
+
+        for (auto& segment : m_state->segments)
+        {
+            if (segment->mapping.is_open())
+            {
+                std::ignore = segment->mapping.retire();
+            }
+        }
+
+        if (m_state->spare != nullptr)
+        {
+            ::unlink(journal::segment_path(m_state->directory, m_state->spare->index).c_str());
+        }
+
+        if (m_state->lock != -1)
+        {
+            ::close(m_state->lock);
+        }
+
+        m_state.reset();
+    }
+
+private:
+    explicit journal_t(std::unique_ptr<state_t> state) noexcept
+        : m_state(std::move(state))
+    {}
+
+    /// Creates segment index after recording in the lock file that every
+    /// index up to it is taken.
+    [[nodiscard]] result_t<std::unique_ptr<segment_t>, std::errc> make_segment(std::uint64_t index) const
+    {
+        std::uint64_t next = index + 1;
+
+        if (::pwrite(m_state->lock, &next, sizeof(next), 0) != static_cast<ssize_t>(sizeof(next)))
+        {
+            return fail_t<std::errc>(journal::last_error());
+        }
+
+        journal::segment_header_t header{journal::magic, index, m_state->options.segment_size, m_state->origin};
+        auto mapping = journal::mapping_t::create(journal::segment_path(m_state->directory, index), header);
+
+        if (!mapping)
+        {
+            return fail_t<std::errc>(mapping.error());
+        }
+
+        auto segment = std::make_unique<segment_t>();
+        segment->mapping = std::move(*mapping);
+        segment->index = index;
+
+        return success_t<std::unique_ptr<segment_t>>(std::move(segment));
+    }
+
+    static void write(segment_t& segment, std::size_t start, const journal::frame_header_t& header, std::span<const iovec> vectors) noexcept
+    {
+        constexpr std::size_t word = sizeof(header.commit);
+        constexpr std::size_t length_offset = offsetof(journal::frame_header_t, length);
+        constexpr std::size_t timestamp_offset = offsetof(journal::frame_header_t, timestamp);
+
+        std::byte* frame = segment.mapping.data() + start;
+        std::size_t offset = sizeof(header);
+
+        std::memcpy(frame + length_offset, &header.length, sizeof(header.length));
+        journal::commit_word(frame).store(journal::reserved, std::memory_order_release);
+
+        for (const auto& vector : vectors)
+        {
+            std::memcpy(frame + offset, vector.iov_base, vector.iov_len);
+            offset += vector.iov_len;
+        }
+
+        // The length is not written again: a reader may be stepping over it.
+        std::memcpy(frame + word, reinterpret_cast<const std::byte*>(&header) + word, length_offset - word);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        std::memcpy(frame + timestamp_offset, &header.timestamp, sizeof(header.timestamp));
+        journal::commit_word(frame).store(journal::committed, std::memory_order_release);
+
+        segment.committed.fetch_add(journal::frame_size(header.length), std::memory_order_release);
+    }
+
+    /// Offset of the first frame from first on that is not committed yet,
+    /// or last if every frame up to it is.
+    static std::size_t settled(const segment_t& segment, std::size_t first, std::size_t last) noexcept
+    {
+        while (first < last && last - first >= sizeof(journal::frame_header_t))
+        {
+            const std::byte* frame = segment.mapping.data() + first;
+            std::uint32_t commit = journal::commit_word(frame).load(std::memory_order_acquire);
+
+            if (commit == journal::skipped)
+            {
+                return last;
+            }
+
+            if (commit != journal::committed)
+            {
+                return first;
+            }
+
+            journal::frame_header_t header{};
+            std::memcpy(&header, frame, sizeof(header));
+
+            first += journal::frame_size(header.length);
+        }
+
+        return last;
+    }
+
+    /// Run by the one writer whose reservation starts inside the segment but
+    /// ends past it: closes the segment and publishes the next one, or a
+    /// null segment that fails every append if it cannot be created.
+    void roll(segment_t& segment, std::size_t start)
+    {
+        std::size_t capacity = segment.mapping.size();
+
+        if (capacity - start >= sizeof(journal::frame_header_t))
+        {
+            journal::commit_word(segment.mapping.data() + start).store(journal::skipped, std::memory_order_release);
+        }
+
+        segment.committed.fetch_add(capacity - start, std::memory_order_release);
+
+        std::lock_guard lock(m_state->mutex);
+
+        if (m_state->spare == nullptr)
+        {
+            auto next = make_segment(segment.index + 1);
+
+            if (next)
+            {
+                m_state->spare = std::move(*next);
+            }
+            else
+            {
+                m_state->error.store(next.error(), std::memory_order_relaxed);
+            }
+        }
+
+        if (m_state->spare != nullptr)
+        {
+            m_state->segments.push_back(std::move(m_state->spare));
+            m_state->current.store(m_state->segments.back().get(), std::memory_order_release);
+        }
+        else
+        {
+            m_state->current.store(nullptr, std::memory_order_release);
+        }
+
+        m_state->current.notify_all();
+    }
+
+    std::unique_ptr<state_t> m_state;
+};
+
+// Reads a journal directory, following it while a journal_t appends to it.
+// Frames are indexed in the order their space was reserved, which matches
+// their timestamps except where concurrent appends raced.
+//
+// A hole in a segment, space reserved but never committed, stops the scan
+// until refresh() finds it filled, unless no writer can fill it any more: a
+// later segment was started by a newer journal_t, or no journal_t holds the
+// directory. The scan then steps over the hole, or finishes the segment if
+// nothing was reserved past it.
+class journal_reader_t
+{
+    struct location_t
+    {
+        std::size_t segment;
+        std::size_t offset;
+    };
+
+public:
+    [[nodiscard]] static result_t<journal_reader_t, std::errc> open(const std::filesystem::path& directory)
+    {
+        journal_reader_t reader(directory);
+        auto indexed = reader.refresh();
+
+        if (!indexed)
+        {
+            return fail_t<std::errc>(indexed.error());
+        }
+
+        return success_t<journal_reader_t>(std::move(reader));
+    }
+
+    /// Maps new segments and indexes the frames committed since the last
+    /// call, returning how many there were.
+    [[nodiscard]] result_t<std::size_t, std::errc> refresh()
+    {
+        auto listed = journal::list_segments(m_directory);
+
+        if (!listed)
+        {
+            return fail_t<std::errc>(listed.error());
+        }
+
+        for (auto index : *listed)
+        {
+            if (!m_segments.empty() && index <= m_segments.back().header().index)
+            {
+                continue;
+            }
+
+            auto mapping = journal::mapping_t::open(journal::segment_path(m_directory, index));
+
+            if (!mapping && mapping.error() == std::errc::invalid_argument)
+            {
+                break;
+            }
+
+            if (!mapping)
+            {
+                return fail_t<std::errc>(mapping.error());
+            }
+
+            m_segments.push_back(std::move(*mapping));
+        }
+
+        std::size_t before = m_frames.size();
+
+        while (m_segment < m_segments.size() && scan(m_segments[m_segment]))
+        {
+            ++m_segment;
+            m_offset = journal::data_offset;
+        }
+
+        return success_t<std::size_t>(m_frames.size() - before);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_frames.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_frames.empty();
+    }
+
+    [[nodiscard]] journal_frame_t operator[](std::size_t index) const noexcept
+    {
+        const auto& location = m_frames[index];
+        auto header = frame_header(location);
+        auto payload = std::span<const std::byte>(m_segments[location.segment].data() + location.offset + sizeof(header), header.length);
+
+        iovec vector{const_cast<std::byte*>(payload.data()), payload.size()};  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+
+        return journal_frame_t{journal_time_t(std::chrono::nanoseconds(header.timestamp)), header.stream, payload,
+                               journal::checksum(header, std::span<const iovec>(&vector, 1)) == header.checksum};
+    }
+
+    /// Index of the first frame appended at or after time.
+    [[nodiscard]] std::size_t lower_bound(journal_time_t time) const noexcept
+    {
+        std::size_t first = 0;
+        std::size_t count = m_frames.size();
+
+        while (count != 0)
+        {
+            std::size_t step = count / 2;
+
+            if (frame_header(m_frames[first + step]).timestamp < time.time_since_epoch().count())
+            {
+                first += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        return first;
+    }
+
+private:
+    explicit journal_reader_t(std::filesystem::path directory)
+        : m_directory(std::move(directory))
+    {}
+
+    [[nodiscard]] journal::frame_header_t frame_header(const location_t& location) const noexcept
+    {
+        journal::frame_header_t header{};
+        std::memcpy(&header, m_segments[location.segment].data() + location.offset, sizeof(header));
+
+        return header;
+    }
+
+    /// Indexes committed frames from m_offset on and returns whether the
+    /// segment is finished.
+    bool scan(const journal::mapping_t& segment)
+    {
+        while (m_offset + sizeof(journal::frame_header_t) <= segment.size())
+        {
+            const std::byte* frame = segment.data() + m_offset;
+            std::uint32_t commit = journal::commit_word(frame).load(std::memory_order_acquire);
+
+            if (commit == journal::skipped)
+            {
+                return true;
+            }
+
+            if (commit != journal::committed)
+            {
+                if (!abandoned())
+                {
+                    return false;
+                }
+
+                if (commit != journal::reserved)
+                {
+                    return true;
+                }
+
+                std::uint32_t length = 0;
+                std::memcpy(&length, frame + offsetof(journal::frame_header_t, length), sizeof(length));
+
+                if (journal::frame_size(length) > segment.size() - m_offset)
+                {
+                    return true;
+                }
+
+                m_offset += journal::frame_size(length);
+                continue;
+            }
+
+            journal::frame_header_t header{};
+            std::memcpy(&header, frame, sizeof(header));
+
+            std::size_t size = journal::frame_size(header.length);
+
+            if (size > segment.size() - m_offset)
+            {
+                return true;
+            }
+
+            m_frames.push_back(location_t{m_segment, m_offset});
+            m_offset += size;
+        }
+
+        return true;
+    }
+
+    /// Whether the hole at m_offset can never be filled.
+    [[nodiscard]] bool abandoned() const
+    {
+        if (m_segments.back().header().origin > m_segments[m_segment].header().index)
+        {
+            return true;
+        }
+
+        int lock = ::open((m_directory / journal::lock_name).c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (lock == -1)
+        {
+            return true;
+        }
+
+        bool writable = ::flock(lock, LOCK_SH | LOCK_NB) == -1;
+        ::close(lock);
+
+        return !writable;
+    }
+
+    std::filesystem::path m_directory;
+    std::vector<journal::mapping_t> m_segments;
+    std::vector<location_t> m_frames;
+
+    /// Where scanning resumes.
+    std::size_t m_segment = 0;
+    std::size_t m_offset = journal::data_offset;
+};
+
+// A transport that passes everything through to another one and appends
+// each chunk it receives to a journal as one frame of its stream. Recording
+// never fails the transport; appends that fail are only counted.
+template <transport Transport>
+class recorder_t
+{
+public:
+    recorder_t(const Transport& transport, journal_t& journal, std::uint32_t stream) noexcept
+        : m_transport(transport)
+        , m_journal(journal)
+        , m_stream(stream)
+    {}
+
+    [[nodiscard]] io_result_t send(const void* data, std::size_t length) const
+    {
+        return m_transport.send(data, length);
+    }
+
+    [[nodiscard]] io_result_t send(std::span<const iovec> vectors) const
+        requires gather_transport<Transport>
+    {
+        return m_transport.send(vectors);
+    }
+
+    [[nodiscard]] io_result_t recv(void* data, std::size_t length) const
+    {
+        auto received = m_transport.recv(data, length);
+
+        if (!received)
+        {
+            return fail_t<std::errc>(received.error());
+        }
+
+        if (*received != 0 && !m_journal.append(m_stream, data, *received))
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return success_t<std::size_t>(*received);
+    }
+
+    /// Received chunks the journal did not take.
+    [[nodiscard]] std::size_t dropped() const noexcept
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    const Transport& m_transport;
+    journal_t& m_journal;
+    std::uint32_t m_stream;
+    mutable std::atomic<std::size_t> m_dropped{0};
+};
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+/// Sends the payload of every indexed frame through transport, spaced as
+/// they were recorded divided by options.speed, and returns how many were
+/// sent. Fails with std::errc::bad_message on a frame that does not match
+/// its checksum, and like cancel_token_t::wait() when token fires.
+template <transport Transport>
+[[nodiscard]] result_t<std::size_t, std::errc> replay(const journal_reader_t& reader, const Transport& transport, const replay_options_t& options = {}, const cancel_token_t& token = {})
+{
+    auto origin = std::chrono::steady_clock::now();
+    journal_time_t first{};
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < reader.size(); ++i)
+    {
+        auto frame = reader[i];
+
+        if (options.stream.has_value() && *options.stream != frame.stream)
+        {
+            continue;
+        }
+
+        if (!frame.intact)
+        {
+            return fail_t<std::errc>(std::errc::bad_message);
+        }
+
+        if (count == 0)
+        {
+            first = frame.time;
+        }
+
+        if (options.speed > 0)
+        {
+            std::chrono::duration<double, std::nano> offset = (frame.time - first) / options.speed;
+            auto slept = token.sleep_until(origin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset));
+
+            if (!slept)
+            {
+                return fail_t<std::errc>(slept.error());
+            }
+        }
+        else if (token.cancelled() || token.expired())
+        {
+            return fail_t<std::errc>(token.cancelled() ? std::errc::operation_canceled : std::errc::timed_out);
+        }
+
+        for (std::size_t sent = 0; sent < frame.payload.size();)
+        {
+            auto result = transport.send(frame.payload.data() + sent, frame.payload.size() - sent);
+
+            if (!result)
+            {
+                return fail_t<std::errc>(result.error());
+            }
+
+            sent += *result;
+        }
+
+        ++count;
+    }
+
+    return success_t<std::size_t>(count);
+}
+
+#endif  // JOURNAL_HPP
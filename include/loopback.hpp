@@ -0,0 +1,356 @@
+#ifndef LOOPBACK_HPP
+#define LOOPBACK_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "cpu.hpp"
+#include "transport.hpp"
+
+#include <sys/uio.h>
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// An in-process byte pipe with the transport interface of socket_t, for
+// running framing and protocol code at memory speed and for stress tests
+// that must not depend on the kernel. Each direction is a lock-free
+// single-producer/single-consumer ring on the heap; each side caches the
+// peer's index and only rereads it when what it knows of the ring cannot
+// satisfy the call.
+//
+// Blocking endpoints spin briefly and then sleep on std::atomic::wait, like
+// channel_t; non-blocking ones fail with std::errc::operation_would_block,
+// so a single thread can drive both ends deterministically. Destroying or
+// closing either end closes both directions: recv drains what is left and
+// then yields 0 bytes, send fails with std::errc::broken_pipe.
+class loopback_t
+{
+    static constexpr std::size_t cache_line = 64;
+    static constexpr int spin_limit = 4096;
+
+    struct ring_t
+    {
+        alignas(cache_line) std::atomic<std::uint64_t> head{0};
+        alignas(cache_line) std::atomic<std::uint64_t> tail{0};
+        alignas(cache_line) std::atomic<std::uint32_t> readers_waiting{0};
+        std::atomic<std::uint32_t> writers_waiting{0};
+        std::unique_ptr<std::byte[]> bytes;  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays)
+    };
+
+    struct state_t
+    {
+        std::size_t capacity;
+        bool blocking;
+        std::atomic<bool> closed{false};
+        ring_t rings[2];  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays)
+    };
+
+public:
+    [[nodiscard]] static result_t<std::pair<loopback_t, loopback_t>, std::errc> pair(std::size_t capacity, bool blocking = true)
+    {
+        auto state = std::make_shared<state_t>();
+
+        state->capacity = std::bit_ceil(std::max<std::size_t>(capacity, cache_line));
+        state->blocking = blocking;
+
+        for (auto& ring : state->rings)
+        {
+            ring.bytes = std::make_unique_for_overwrite<std::byte[]>(state->capacity);  // NOLINT(cppcoreguidelines-avoid-c-arrays, hicpp-avoid-c-arrays)
+        }
+
+        return success_t<std::pair<loopback_t, loopback_t>>(loopback_t(state, 0), loopback_t(state, 1));
+    }
+
+    loopback_t(loopback_t&& that) noexcept
+        : m_state(std::move(that.m_state))
+        , m_side(that.m_side)
+        , m_head(that.m_head)
+        , m_tail(that.m_tail)
+    {}
+
+    loopback_t& operator=(loopback_t&& that) noexcept
+    {
+        if (this != std::addressof(that))
+        {
+            close();
+
+            m_state = std::move(that.m_state);
+            m_side = that.m_side;
+            m_head = that.m_head;
+            m_tail = that.m_tail;
+        }
+
+        return *this;
+    }
+
+    ~loopback_t()
+    {
+        close();
+    }
+
+    loopback_t(const loopback_t& /* that */) = delete;
+    loopback_t& operator=(const loopback_t& /* that */) = delete;
+
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return m_state != nullptr;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return m_state != nullptr ? m_state->capacity : 0;
+    }
+
+    void close()
+    {
+        if (m_state == nullptr)
+        {
+            return;
+        }
+
+        m_state->closed.store(true, std::memory_order_seq_cst);
+
+        for (auto& ring : m_state->rings)
+        {
+            wake(ring.readers_waiting);
+            wake(ring.writers_waiting);
+        }
+
+        m_state.reset();
+    }
+
+    [[nodiscard]] io_result_t send(std::string_view message) const
+    {
+        return send(message.data(), message.length());
+    }
+
+    [[nodiscard]] io_result_t send(const void* data, std::size_t length) const
+    {
+        iovec vector{const_cast<void*>(data), length};  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        return send(std::span<const iovec>(&vector, 1));
+    }
+
+    /// Copies as much of the vectors as fits into the ring and publishes it
+    /// at once.
+    [[nodiscard]] io_result_t send(std::span<const iovec> vectors) const
+    {
+        if (m_state == nullptr)
+        {
+            return fail_t<std::errc>(std::errc::bad_file_descriptor);
+        }
+
+        if (m_state->closed.load(std::memory_order_relaxed))
+        {
+            return fail_t<std::errc>(std::errc::broken_pipe);
+        }
+
+        auto& ring = m_state->rings[m_side];
+        std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+        std::size_t length = 0;
+
+        for (const auto& vector : vectors)
+        {
+            length += vector.iov_len;
+        }
+
+        if (m_state->capacity - (head - m_tail) < length)
+        {
+            m_tail = ring.tail.load(std::memory_order_acquire);
+        }
+
+        if (head - m_tail == m_state->capacity && length != 0)
+        {
+            auto full = wait_for(ring.tail, ring.writers_waiting, m_tail, [&](std::uint64_t tail) {
+                return head - tail < m_state->capacity;
+            });
+
+            if (full.has_value())
+            {
+                return fail_t<std::errc>(*full);
+            }
+        }
+
+        std::size_t count = std::min(length, static_cast<std::size_t>(m_state->capacity - (head - m_tail)));
+        std::size_t copied = 0;
+
+        for (std::size_t i = 0; copied < count; ++i)
+        {
+            std::size_t step = std::min(vectors[i].iov_len, count - copied);
+
+            copy_in(ring.bytes.get(), head + copied, static_cast<const std::byte*>(vectors[i].iov_base), step);
+            copied += step;
+        }
+
+        ring.head.store(head + count, std::memory_order_seq_cst);
+
+        if (ring.readers_waiting.load(std::memory_order_seq_cst) != 0 && ring.readers_waiting.exchange(0) != 0)
+        {
+            wake(ring.readers_waiting);
+        }
+
+        return success_t<std::size_t>(count);
+    }
+
+    [[nodiscard]] io_result_t recv(void* data, std::size_t length) const
+    {
+        if (m_state == nullptr)
+        {
+            return fail_t<std::errc>(std::errc::bad_file_descriptor);
+        }
+
+        auto& ring = m_state->rings[m_side ^ 1U];
+        std::uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+
+        if (m_head - tail < length)
+        {
+            m_head = ring.head.load(std::memory_order_acquire);
+        }
+
+        if (m_head == tail && length != 0)
+        {
+            auto empty = wait_for(ring.head, ring.readers_waiting, m_head, [tail](std::uint64_t head) {
+                return head != tail;
+            });
+
+            if (empty.has_value() && *empty == std::errc::broken_pipe)
+            {
+                return success_t<std::size_t>(std::size_t{0});
+            }
+
+            if (empty.has_value())
+            {
+                return fail_t<std::errc>(*empty);
+            }
+        }
+
+        std::size_t count = std::min(length, static_cast<std::size_t>(m_head - tail));
+
+        copy_out(ring.bytes.get(), tail, static_cast<std::byte*>(data), count);
+
+        ring.tail.store(tail + count, std::memory_order_seq_cst);
+
+        if (ring.writers_waiting.load(std::memory_order_seq_cst) != 0 && ring.writers_waiting.exchange(0) != 0)
+        {
+            wake(ring.writers_waiting);
+        }
+
+        return success_t<std::size_t>(count);
+    }
+
+private:
+    loopback_t(std::shared_ptr<state_t> state, std::size_t side)
+        : m_state(std::move(state))
+        , m_side(side)
+    {}
+
+    /// Waits until ready(index) holds for a fresh read of index, storing it
+    /// in cached. Fails with broken_pipe once closed and nothing is ready,
+    /// and with operation_would_block right away for non-blocking endpoints.
+    template <typename F>
+    maybe_t<std::errc> wait_for(const std::atomic<std::uint64_t>& index, std::atomic<std::uint32_t>& waiting, std::uint64_t& cached, F&& ready) const
+    {
+        for (int spins = 0;; ++spins)
+        {
+            cached = index.load(std::memory_order_acquire);
+
+            if (ready(cached))
+            {
+                return utils::nothing;
+            }
+
+            if (m_state->closed.load(std::memory_order_acquire))
+            {
+                // The peer may have moved index just before closing.
+                cached = index.load(std::memory_order_acquire);
+
+                if (ready(cached))
+                {
+                    return utils::nothing;
+                }
+
+                return std::errc::broken_pipe;
+            }
+
+            if (!m_state->blocking)
+            {
+                return std::errc::operation_would_block;
+            }
+
+            if (spins < spin_budget())
+            {
+                cpu_t::relax();
+                continue;
+            }
+
+            waiting.store(1, std::memory_order_seq_cst);
+
+            if (!ready(index.load(std::memory_order_seq_cst)) && !m_state->closed.load(std::memory_order_seq_cst))
+            {
+                waiting.wait(1, std::memory_order_seq_cst);
+            }
+            else
+            {
+                waiting.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void copy_in(std::byte* ring, std::uint64_t position, const std::byte* data, std::size_t count) const noexcept
+    {
+        auto offset = static_cast<std::size_t>(position & (m_state->capacity - 1));
+        auto first = std::min(count, m_state->capacity - offset);
+
+        std::memcpy(ring + offset, data, first);
+        std::memcpy(ring, data + first, count - first);
+    }
+
+    void copy_out(const std::byte* ring, std::uint64_t position, std::byte* data, std::size_t count) const noexcept
+    {
+        auto offset = static_cast<std::size_t>(position & (m_state->capacity - 1));
+        auto first = std::min(count, m_state->capacity - offset);
+
+        std::memcpy(data, ring + offset, first);
+        std::memcpy(data + first, ring, count - first);
+    }
+
+    // Spinning only pays off when the peer can run concurrently.
+    static int spin_budget() noexcept
+    {
+        static const int budget = std::thread::hardware_concurrency() > 1 ? spin_limit : 0;
+        return budget;
+    }
+
+    static void wake(std::atomic<std::uint32_t>& word) noexcept
+    {
+        word.store(0, std::memory_order_seq_cst);
+        word.notify_all();
+    }
+
+    std::shared_ptr<state_t> m_state;
+    std::size_t m_side;
+
+    /// Last seen head of the inbound ring and tail of the outbound one.
+    mutable std::uint64_t m_head = 0;
+    mutable std::uint64_t m_tail = 0;
+};
+
+static_assert(gather_transport<loopback_t>);
+
+#endif  // LOOPBACK_HPP
@@ -8,6 +8,8 @@
 
 /// \cond
 #include <functional>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 /// \endcond
@@ -314,7 +316,7 @@ public:
     }
 
     template <typename F, typename... Args>
-        requires(!std::is_same_v<std::invoke_result_t<F, Args..., value_type&>, void>)
+        requires(!std::is_same_v<std::invoke_result_t<F, Args..., value_type&&>, void>)
     constexpr auto and_then(F&& fn, Args&&... args) &&
     {
         using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., value_type&&>>;
@@ -328,7 +330,7 @@ public:
     }
 
     template <typename F, typename... Args>
-        requires(!std::is_same_v<std::invoke_result_t<F, Args..., value_type&>, void>)
+        requires(!std::is_same_v<std::invoke_result_t<F, Args..., value_type&&>, void>)
     constexpr auto and_then(F&& fn, Args&&... args) const&&
     {
         using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., value_type&&>>;
@@ -493,7 +495,344 @@ private:
     bool m_has_value = false;
 };
 
+template <typename T>
+class maybe_t<T&>
+{
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, utils::nothing_t>);
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, utils::something_t>);
+
+public:
+    using value_type = T&;
+
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    constexpr maybe_t(T& value) noexcept
+        : m_pointer(std::addressof(value))
+    {}
+
+    maybe_t(T&& value) = delete;  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+
+    template <typename U>
+        requires(!std::is_same_v<U, T> && std::is_convertible_v<U*, T*>)
+    constexpr maybe_t(const maybe_t<U&>& that) noexcept  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        : m_pointer(that.has_value() ? std::addressof(*that) : nullptr)
+    {}
+
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    constexpr maybe_t(utils::nothing_t /* unused */) noexcept
+    {}
+
+    constexpr maybe_t(const maybe_t& that) noexcept = default;
+    constexpr maybe_t(maybe_t&& that) noexcept = default;
+
+    constexpr ~maybe_t() = default;
+
+    constexpr maybe_t& operator=(const maybe_t& that) noexcept = default;
+    constexpr maybe_t& operator=(maybe_t&& that) noexcept = default;
+
+    constexpr maybe_t& operator=(utils::nothing_t /* unused */) noexcept
+    {
+        this->reset();
+        return *this;
+    }
+
+    [[nodiscard]] constexpr bool has_value() const
+    {
+        return m_pointer != nullptr;
+    }
+
+    explicit constexpr operator bool() const noexcept
+    {
+        return m_pointer != nullptr;
+    }
+
+    constexpr T& operator*() const noexcept
+    {
+        return *m_pointer;
+    }
+
+    constexpr T* operator->() const noexcept
+    {
+        return m_pointer;
+    }
+
+    constexpr void reset() noexcept
+    {
+        m_pointer = nullptr;
+    }
+
+    constexpr void swap(maybe_t& that) noexcept
+    {
+        std::swap(m_pointer, that.m_pointer);
+    }
+
+    constexpr friend void swap(maybe_t& lhs, maybe_t& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    template <typename F, typename... Args>
+    constexpr auto now(F&& fn, Args&&... args) &
+    {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., T&>>;
+
+        if (has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return U(utils::nothing);
+    }
+
+    template <typename F, typename... Args>
+    constexpr auto now(F&& fn, Args&&... args) const&
+    {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., T&>>;
+
+        if (has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return U(utils::nothing);
+    }
+
+    template <typename F, typename... Args>
+    constexpr auto now(F&& fn, Args&&... args) &&
+    {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., T&>>;
+
+        if (has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return U(utils::nothing);
+    }
+
+    template <typename F, typename... Args>
+    constexpr auto now(F&& fn, Args&&... args) const&&
+    {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., T&>>;
+
+        if (has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return U(utils::nothing);
+    }
+
+    template <typename F, typename... Args>
+        requires(std::is_same_v<std::invoke_result_t<F, Args..., T&>, void>)
+    constexpr maybe_t& and_then(F&& fn, Args&&... args) &
+    {
+        if (has_value())
+        {
+            std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return *this;
+    }
+
+    template <typename F, typename... Args>
+        requires(std::is_same_v<std::invoke_result_t<F, Args..., T&>, void>)
+    constexpr const maybe_t& and_then(F&& fn, Args&&... args) const&
+    {
+        if (has_value())
+        {
+            std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return *this;
+    }
+
+    template <typename F, typename... Args>
+        requires(std::is_same_v<std::invoke_result_t<F, Args..., T&>, void>)
+    constexpr maybe_t&& and_then(F&& fn, Args&&... args) &&
+    {
+        if (has_value())
+        {
+            std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return std::move(*this);
+    }
+
+    template <typename F, typename... Args>
+        requires(std::is_same_v<std::invoke_result_t<F, Args..., T&>, void>)
+    constexpr const maybe_t&& and_then(F&& fn, Args&&... args) const&&
+    {
+        if (has_value())
+        {
+            std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return std::move(*this);
+    }
+
+    template <typename F, typename... Args>
+        requires(!std::is_same_v<std::invoke_result_t<F, Args..., T&>, void>)
+    constexpr auto and_then(F&& fn, Args&&... args) &
+    {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., T&>>;
+
+        if (has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return U(utils::nothing);
+    }
+
+    template <typename F, typename... Args>
+        requires(!std::is_same_v<std::invoke_result_t<F, Args..., T&>, void>)
+    constexpr auto and_then(F&& fn, Args&&... args) const&
+    {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., T&>>;
+
+        if (has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return U(utils::nothing);
+    }
+
+    template <typename F, typename... Args>
+        requires(!std::is_same_v<std::invoke_result_t<F, Args..., T&>, void>)
+    constexpr auto and_then(F&& fn, Args&&... args) &&
+    {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., T&>>;
+
+        if (has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return U(utils::nothing);
+    }
+
+    template <typename F, typename... Args>
+        requires(!std::is_same_v<std::invoke_result_t<F, Args..., T&>, void>)
+    constexpr auto and_then(F&& fn, Args&&... args) const&&
+    {
+        using U = std::remove_cvref_t<std::invoke_result_t<F, Args..., T&>>;
+
+        if (has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)..., *m_pointer);
+        }
+
+        return U(utils::nothing);
+    }
+
+    template <typename F, typename... Args>
+        requires(std::is_same_v<std::invoke_result_t<F, Args...>, void>)
+    constexpr maybe_t& or_else(F&& fn, Args&&... args) &
+    {
+        if (!has_value())
+        {
+            std::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        }
+
+        return *this;
+    }
+
+    template <typename F, typename... Args>
+        requires(std::is_same_v<std::invoke_result_t<F, Args...>, void>)
+    constexpr const maybe_t& or_else(F&& fn, Args&&... args) const&
+    {
+        if (!has_value())
+        {
+            std::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        }
+
+        return *this;
+    }
+
+    template <typename F, typename... Args>
+        requires(std::is_same_v<std::invoke_result_t<F, Args...>, void>)
+    constexpr maybe_t&& or_else(F&& fn, Args&&... args) &&
+    {
+        if (!has_value())
+        {
+            std::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        }
+
+        return std::move(*this);
+    }
+
+    template <typename F, typename... Args>
+        requires(std::is_same_v<std::invoke_result_t<F, Args...>, void>)
+    constexpr const maybe_t&& or_else(F&& fn, Args&&... args) const&&
+    {
+        if (!has_value())
+        {
+            std::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        }
+
+        return std::move(*this);
+    }
+
+    template <typename F, typename... Args>
+        requires(!std::is_same_v<std::invoke_result_t<F, Args...>, void>)
+    constexpr auto or_else(F&& fn, Args&&... args) &
+    {
+        if (!has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        }
+
+        return *this;
+    }
+
+    template <typename F, typename... Args>
+        requires(!std::is_same_v<std::invoke_result_t<F, Args...>, void>)
+    constexpr auto or_else(F&& fn, Args&&... args) const&
+    {
+        if (!has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        }
+
+        return *this;
+    }
+
+    template <typename F, typename... Args>
+        requires(!std::is_same_v<std::invoke_result_t<F, Args...>, void>)
+    constexpr auto or_else(F&& fn, Args&&... args) &&
+    {
+        if (!has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        }
+
+        return *this;
+    }
+
+    template <typename F, typename... Args>
+        requires(!std::is_same_v<std::invoke_result_t<F, Args...>, void>)
+    constexpr auto or_else(F&& fn, Args&&... args) const&&
+    {
+        if (!has_value())
+        {
+            return std::invoke(std::forward<F>(fn), std::forward<Args>(args)...);
+        }
+
+        return *this;
+    }
+
+private:
+    T* m_pointer = nullptr;
+};
+
 template <typename T>
 maybe_t(T) -> maybe_t<T>;
 
+template <typename T>
+inline constexpr bool is_maybe_v = false;
+
+template <typename T>
+inline constexpr bool is_maybe_v<maybe_t<T>> = true;
+
 #endif  // MAYBE_HPP
@@ -0,0 +1,255 @@
+#ifndef OUTPUT_BUFFER_HPP
+#define OUTPUT_BUFFER_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "transport.hpp"
+
+#include <sys/uio.h>
+
+#include <limits.h>
+
+/// \cond
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// Per-connection output gathered during an event-loop tick and written with
+// one sendmsg per flush. Small writes are copied into an owned arena and
+// coalesced; append_reference() queues caller-owned memory, which has to
+// stay valid until it has been flushed. Whatever the transport does not take
+// is kept for the next writable event.
+//
+// accepting() applies back-pressure with hysteresis: it turns false once the
+// pending bytes reach the high watermark and true again only after they
+// drain below the low one.
+class output_buffer_t
+{
+    static constexpr std::size_t default_low_watermark = 16 * 1024;
+    static constexpr std::size_t default_high_watermark = 64 * 1024;
+    static constexpr std::size_t max_vectors = std::min<std::size_t>(IOV_MAX, 64);
+
+    struct segment_t
+    {
+        const std::byte* external;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+public:
+    output_buffer_t()
+        : output_buffer_t(default_low_watermark, default_high_watermark)
+    {}
+
+    output_buffer_t(std::size_t low_watermark, std::size_t high_watermark)
+        : m_low_watermark(std::min(low_watermark, high_watermark))
+        , m_high_watermark(high_watermark)
+    {}
+
+    void append(std::string_view message)
+    {
+        append(message.data(), message.length());
+    }
+
+    void append(const void* data, std::size_t length)
+    {
+        if (length == 0)
+        {
+            return;
+        }
+
+        std::size_t offset = m_arena.size();
+
+        m_arena.resize(offset + length);
+        std::memcpy(m_arena.data() + offset, data, length);
+
+        if (!m_segments.empty() && m_segments.back().external == nullptr
+            && m_segments.back().offset + m_segments.back().length == offset)
+        {
+            m_segments.back().length += length;
+        }
+        else
+        {
+            m_segments.push_back(segment_t{nullptr, offset, length});
+        }
+
+        grow(length);
+    }
+
+    void append_reference(const void* data, std::size_t length)
+    {
+        if (length == 0)
+        {
+            return;
+        }
+
+        m_segments.push_back(segment_t{static_cast<const std::byte*>(data), 0, length});
+        grow(length);
+    }
+
+    [[nodiscard]] std::size_t pending() const noexcept
+    {
+        return m_pending;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_pending == 0;
+    }
+
+    [[nodiscard]] bool accepting() const noexcept
+    {
+        return !m_throttled;
+    }
+
+    /// Writes as much as the transport accepts without blocking on a partial
+    /// write; errors such as operation_would_block leave the buffer intact.
+    template <gather_transport Transport>
+    [[nodiscard]] io_result_t flush(const Transport& transport)
+    {
+        std::size_t total = 0;
+
+        while (m_first < m_segments.size())
+        {
+            std::array<iovec, max_vectors> vectors{};
+            std::size_t count = 0;
+            std::size_t requested = 0;
+
+            for (std::size_t i = m_first; i < m_segments.size() && count < vectors.size(); ++i, ++count)
+            {
+                vectors[count] = iovec{const_cast<std::byte*>(address(m_segments[i])), m_segments[i].length};  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+                requested += m_segments[i].length;
+            }
+
+            auto sent = transport.send(std::span<const iovec>(vectors.data(), count));
+
+            if (!sent)
+            {
+                if (total != 0 && sent.error() == std::errc::operation_would_block)
+                {
+                    break;
+                }
+
+                return fail_t<std::errc>(sent.error());
+            }
+
+            consume(*sent);
+            total += *sent;
+
+            if (*sent < requested)
+            {
+                break;
+            }
+        }
+
+        compact();
+
+        return success_t<std::size_t>(total);
+    }
+
+private:
+    [[nodiscard]] const std::byte* address(const segment_t& segment) const noexcept
+    {
+        return segment.external != nullptr ? segment.external + segment.offset : m_arena.data() + segment.offset;
+    }
+
+    void grow(std::size_t length) noexcept
+    {
+        m_pending += length;
+
+        if (m_pending >= m_high_watermark)
+        {
+            m_throttled = true;
+        }
+    }
+
+    void consume(std::size_t length) noexcept
+    {
+        m_pending -= length;
+
+        while (length != 0)
+        {
+            auto& segment = m_segments[m_first];
+            auto step = std::min(length, segment.length);
+
+            segment.offset += step;
+            segment.length -= step;
+            length -= step;
+
+            if (segment.length == 0)
+            {
+                ++m_first;
+            }
+        }
+
+        if (m_first == m_segments.size())
+        {
+            m_segments.clear();
+            m_arena.clear();
+            m_first = 0;
+        }
+
+        if (m_pending < m_low_watermark)
+        {
+            m_throttled = false;
+        }
+    }
+
+    // Drops the flushed prefix of the arena and of the segment list once it
+    // makes up more than half of either, so a connection that never drains
+    // completely does not grow without bound.
+    void compact()
+    {
+        if (m_first * 2 > m_segments.size())
+        {
+            m_segments.erase(m_segments.begin(), m_segments.begin() + static_cast<std::ptrdiff_t>(m_first));
+            m_first = 0;
+        }
+
+        std::size_t start = m_arena.size();
+
+        for (std::size_t i = m_first; i < m_segments.size(); ++i)
+        {
+            if (m_segments[i].external == nullptr)
+            {
+                start = m_segments[i].offset;
+                break;
+            }
+        }
+
+        if (start * 2 <= m_arena.size())
+        {
+            return;
+        }
+
+        m_arena.erase(m_arena.begin(), m_arena.begin() + static_cast<std::ptrdiff_t>(start));
+
+        for (std::size_t i = m_first; i < m_segments.size(); ++i)
+        {
+            if (m_segments[i].external == nullptr)
+            {
+                m_segments[i].offset -= start;
+            }
+        }
+    }
+
+    std::vector<std::byte> m_arena;
+    std::vector<segment_t> m_segments;
+    std::size_t m_first = 0;
+    std::size_t m_pending = 0;
+    std::size_t m_low_watermark;
+    std::size_t m_high_watermark;
+    bool m_throttled = false;
+};
+
+#endif  // OUTPUT_BUFFER_HPP
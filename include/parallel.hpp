@@ -0,0 +1,77 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+/// \cond
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+namespace utils
+{
+    struct sequenced_t
+    {};
+
+    struct parallel_t
+    {};
+
+    inline constexpr sequenced_t seq{};
+    inline constexpr parallel_t par{};
+}  // namespace utils
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+inline std::size_t chunk_count(std::size_t count, std::size_t grain)
+{
+    static const std::size_t threads = std::max(1U, std::thread::hardware_concurrency());
+
+    std::size_t chunks = (count + grain - 1) / grain;
+
+    return std::clamp<std::size_t>(chunks, 1, threads);
+}
+
+/// Splits [0, count) into at most chunk_count(count, grain) contiguous chunks
+/// whose boundaries are multiples of grain, and calls fn(chunk, begin, end)
+/// for each of them. The first chunk runs on the calling thread.
+template <typename F>
+void for_each_chunk(std::size_t count, std::size_t grain, F&& fn)
+{
+    std::size_t chunks = chunk_count(count, grain);
+    std::size_t step = (count + chunks - 1) / chunks;
+
+    step = (step + grain - 1) / grain * grain;
+
+    std::vector<std::jthread> workers;
+    workers.reserve(chunks - 1);
+
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+    {
+        std::size_t begin = chunk * step;
+
+        if (begin >= count)
+        {
+            break;
+        }
+
+        std::size_t end = std::min(count, begin + step);
+
+        workers.emplace_back([&fn, chunk, begin, end]() {
+            std::invoke(fn, chunk, begin, end);
+        });
+    }
+
+    std::invoke(std::forward<F>(fn), std::size_t{0}, std::size_t{0}, std::min(count, step));
+}
+
+#endif  // PARALLEL_HPP
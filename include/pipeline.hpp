@@ -0,0 +1,208 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "maybe.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+template <typename F>
+struct and_then_t
+{
+    F fn;
+};
+
+template <typename F>
+struct or_else_t
+{
+    F fn;
+};
+
+template <typename T>
+inline constexpr bool is_and_then_v = false;
+
+template <typename F>
+inline constexpr bool is_and_then_v<and_then_t<F>> = true;
+
+template <typename T>
+inline constexpr bool is_stage_v = false;
+
+template <typename F>
+inline constexpr bool is_stage_v<and_then_t<F>> = true;
+
+template <typename F>
+inline constexpr bool is_stage_v<or_else_t<F>> = true;
+
+// A lazy chain of and_then/or_else stages over a maybe_t. Evaluation walks
+// the stages once: a present value is handed from stage to stage as the
+// prvalue its function returned, and an empty state skips straight to the
+// next or_else without re-checking. Only the last produced maybe_t reaches
+// the caller, constructed in place.
+//
+// The source is held by reference, so a pipeline over a temporary has to be
+// evaluated within the same full-expression.
+template <typename Source, typename... Stages>
+class pipeline_t
+{
+    static constexpr std::size_t stage_count = sizeof...(Stages);
+
+public:
+    constexpr pipeline_t(Source&& source, std::tuple<Stages...> stages)
+        : m_source(std::addressof(source))
+        , m_stages(std::move(stages))
+    {}
+
+    template <typename Stage>
+        requires(is_stage_v<Stage>)
+    constexpr pipeline_t<Source, Stages..., Stage> operator|(Stage stage) &&
+    {
+        return {static_cast<Source&&>(*m_source), std::tuple_cat(std::move(m_stages), std::tuple<Stage>(std::move(stage)))};
+    }
+
+    constexpr auto evaluate() &&
+    {
+        return this->run<0>(static_cast<Source&&>(*m_source));
+    }
+
+    template <typename R>
+        requires(std::is_same_v<R, decltype(std::declval<pipeline_t>().evaluate())>)
+    constexpr operator R() &&  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+    {
+        return std::move(*this).evaluate();
+    }
+
+private:
+    template <std::size_t I, typename M>
+    constexpr auto run(M&& current)
+    {
+        using state_type = std::remove_cvref_t<M>;
+
+        if constexpr (I == stage_count)
+        {
+            return state_type(std::forward<M>(current));
+        }
+        else
+        {
+            auto& stage = std::get<I>(m_stages);
+
+            if constexpr (is_and_then_v<std::tuple_element_t<I, std::tuple<Stages...>>>)
+            {
+                using result_type = std::invoke_result_t<decltype(stage.fn)&, decltype(*std::forward<M>(current))>;
+
+                if constexpr (std::is_void_v<result_type>)
+                {
+                    if (current.has_value())
+                    {
+                        std::invoke(stage.fn, *current);
+                        return this->run<I + 1>(std::forward<M>(current));
+                    }
+
+                    return this->run_empty<I + 1, state_type>();
+                }
+                else
+                {
+                    if (current.has_value())
+                    {
+                        if constexpr (I + 1 == stage_count)
+                        {
+                            return std::invoke(stage.fn, *std::forward<M>(current));
+                        }
+                        else
+                        {
+                            return this->run<I + 1>(std::invoke(stage.fn, *std::forward<M>(current)));
+                        }
+                    }
+
+                    return this->run_empty<I + 1, std::remove_cvref_t<result_type>>();
+                }
+            }
+            else
+            {
+                if (current.has_value())
+                {
+                    return this->run<I + 1>(std::forward<M>(current));
+                }
+
+                return this->run_empty<I, state_type>();
+            }
+        }
+    }
+
+    template <std::size_t I, typename State>
+    constexpr auto run_empty()
+    {
+        if constexpr (I == stage_count)
+        {
+            return State(utils::nothing);
+        }
+        else
+        {
+            auto& stage = std::get<I>(m_stages);
+
+            if constexpr (is_and_then_v<std::tuple_element_t<I, std::tuple<Stages...>>>)
+            {
+                using result_type = std::invoke_result_t<decltype(stage.fn)&, decltype(*std::declval<State>())>;
+                using next_type = std::conditional_t<std::is_void_v<result_type>, State, std::remove_cvref_t<result_type>>;
+
+                return this->run_empty<I + 1, next_type>();
+            }
+            else if constexpr (std::is_void_v<std::invoke_result_t<decltype(stage.fn)&>>)
+            {
+                std::invoke(stage.fn);
+                return this->run_empty<I + 1, State>();
+            }
+            else if constexpr (I + 1 == stage_count)
+            {
+                return std::invoke(stage.fn);
+            }
+            else
+            {
+                return this->run<I + 1>(std::invoke(stage.fn));
+            }
+        }
+    }
+
+    std::remove_reference_t<Source>* m_source;
+    std::tuple<Stages...> m_stages;
+};
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+template <typename F>
+constexpr and_then_t<std::decay_t<F>> and_then(F&& fn)
+{
+    return {std::forward<F>(fn)};
+}
+
+template <typename F>
+constexpr or_else_t<std::decay_t<F>> or_else(F&& fn)
+{
+    return {std::forward<F>(fn)};
+}
+
+/*****************************************************************************/
+/*** OPERATORS ***************************************************************/
+
+template <typename M, typename Stage>
+    requires(is_maybe_v<std::remove_cvref_t<M>> && is_stage_v<Stage>)
+constexpr pipeline_t<M, Stage> operator|(M&& source, Stage stage)
+{
+    return {std::forward<M>(source), std::tuple<Stage>(std::move(stage))};
+}
+
+#endif  // PIPELINE_HPP
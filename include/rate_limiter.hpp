@@ -0,0 +1,390 @@
+#ifndef RATE_LIMITER_HPP
+#define RATE_LIMITER_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "cpu.hpp"
+#include "maybe.hpp"
+
+#include <time.h>
+
+/// \cond
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// CLOCK_MONOTONIC_COARSE, served from the vDSO without a system call. It is
+// several times cheaper than steady_clock but only advances once per kernel
+// tick, see resolution().
+struct coarse_clock_t
+{
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<coarse_clock_t>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept
+    {
+        timespec now{};
+        ::clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+
+        return time_point(std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec));
+    }
+
+    static duration resolution() noexcept
+    {
+        timespec resolution{};
+        ::clock_getres(CLOCK_MONOTONIC_COARSE, &resolution);
+
+        return std::chrono::seconds(resolution.tv_sec) + std::chrono::nanoseconds(resolution.tv_nsec);
+    }
+};
+
+// A nanosecond clock read from the invariant time-stamp counter. The
+// counter is calibrated against steady_clock for calibration_window on first
+// use and its ticks are scaled with a 32.32 fixed-point multiply. Without an
+// invariant counter, or one slower than 1 GHz, it falls back to
+// steady_clock. Its epoch is the calibration point, so its time points are
+// only comparable with each other.
+struct tsc_clock_t
+{
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<tsc_clock_t>;
+
+    static constexpr bool is_steady = true;
+    static constexpr std::chrono::milliseconds calibration_window{2};
+
+    static time_point now() noexcept
+    {
+        const auto& scale = calibration();
+
+        if (scale.multiplier == 0)
+        {
+            return time_point(std::chrono::steady_clock::now() - scale.steady_origin);
+        }
+
+        std::uint64_t ticks = cpu_t::timestamp() - scale.tick_origin;
+        std::uint64_t nanos = (ticks >> 32) * scale.multiplier + (((ticks & 0xffffffff) * scale.multiplier) >> 32);
+
+        return time_point(duration(static_cast<rep>(nanos)));
+    }
+
+    /// Whether now() reads the time-stamp counter.
+    static bool precise() noexcept
+    {
+        return calibration().multiplier != 0;
+    }
+
+private:
+    struct calibration_t
+    {
+        std::chrono::steady_clock::time_point steady_origin;
+        std::uint64_t tick_origin;
+        std::uint64_t multiplier;
+    };
+
+    static const calibration_t& calibration() noexcept
+    {
+        static const calibration_t instance = calibrate();
+        return instance;
+    }
+
+    static calibration_t calibrate() noexcept
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        if (!cpu_t::invariant_tsc())
+        {
+            return calibration_t{start, 0, 0};
+        }
+
+        std::uint64_t first = cpu_t::timestamp();
+        auto end = start;
+
+        while (end - start < calibration_window)
+        {
+            cpu_t::relax();
+            end = std::chrono::steady_clock::now();
+        }
+
+        std::uint64_t ticks = cpu_t::timestamp() - first;
+        auto nanos = static_cast<std::uint64_t>(std::chrono::duration_cast<duration>(end - start).count());
+
+        if (ticks <= nanos)
+        {
+            return calibration_t{start, 0, 0};
+        }
+
+        return calibration_t{start, first, (nanos << 32) / ticks};
+    }
+};
+
+namespace pacing
+{
+    // Converts between token counts and the nanoseconds they take to earn at
+    // a fixed rate. Costs round up, so acquiring tokens one at a time at
+    // rates above one per nanosecond is slower than asked; acquire in
+    // batches there.
+    class rate_t
+    {
+    public:
+        explicit rate_t(double tokens_per_second) noexcept
+            : m_nanos_per_token(1e9 / tokens_per_second)
+        {}
+
+        [[nodiscard]] std::int64_t cost(std::size_t tokens) const noexcept
+        {
+            return static_cast<std::int64_t>(std::ceil(static_cast<double>(tokens) * m_nanos_per_token));
+        }
+
+        [[nodiscard]] std::size_t tokens(std::int64_t nanos) const noexcept
+        {
+            return nanos <= 0 ? 0 : static_cast<std::size_t>(static_cast<double>(nanos) / m_nanos_per_token);
+        }
+
+    private:
+        double m_nanos_per_token;
+    };
+
+    template <typename Clock>
+    std::int64_t elapsed(typename Clock::time_point origin) noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count();
+    }
+}  // namespace pacing
+
+// A token bucket holding up to burst tokens and refilled at a fixed rate,
+// safe to share between threads without a lock. It is kept in the generic
+// cell rate form: one atomic word holds the time at which the bucket will
+// be full again, and taking tokens pushes that time forward with a single
+// compare-and-swap. Nothing refills in the background and there is no
+// token count to keep in step with a timestamp.
+template <typename Clock = tsc_clock_t>
+class token_bucket_t
+{
+public:
+    using clock_type = Clock;
+
+    token_bucket_t(double tokens_per_second, std::size_t burst) noexcept
+        : m_rate(tokens_per_second)
+        , m_burst(burst)
+        , m_tolerance(m_rate.cost(burst))
+        , m_origin(Clock::now())
+    {}
+
+    token_bucket_t(const token_bucket_t&) = delete;
+    token_bucket_t(token_bucket_t&&) = delete;
+
+    ~token_bucket_t() = default;
+
+    token_bucket_t& operator=(const token_bucket_t&) = delete;
+    token_bucket_t& operator=(token_bucket_t&&) = delete;
+
+    /// Takes all tokens or none.
+    bool try_acquire(std::size_t tokens = 1) noexcept
+    {
+        std::int64_t now = pacing::elapsed<Clock>(m_origin);
+        std::int64_t full = m_full.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            std::int64_t next = std::max(full, now) + m_rate.cost(tokens);
+
+            if (next - now > m_tolerance)
+            {
+                return false;
+            }
+
+            if (m_full.compare_exchange_weak(full, next, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+    }
+
+    /// Takes as many of the requested tokens as are available and returns
+    /// how many that was.
+    std::size_t acquire_up_to(std::size_t tokens) noexcept
+    {
+        std::int64_t now = pacing::elapsed<Clock>(m_origin);
+        std::int64_t full = m_full.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            std::int64_t start = std::max(full, now);
+            std::size_t granted = std::min(tokens, m_rate.tokens(now + m_tolerance - start));
+
+            if (granted == 0)
+            {
+                return 0;
+            }
+
+            if (m_full.compare_exchange_weak(full, start + m_rate.cost(granted), std::memory_order_relaxed))
+            {
+                return granted;
+            }
+        }
+    }
+
+    /// Returns tokens acquired but not used.
+    void release(std::size_t tokens) noexcept
+    {
+        m_full.fetch_sub(m_rate.cost(tokens), std::memory_order_relaxed);
+    }
+
+    /// Time until tokens (at most burst) will be available.
+    [[nodiscard]] std::chrono::nanoseconds wait_time(std::size_t tokens) const noexcept
+    {
+        std::int64_t now = pacing::elapsed<Clock>(m_origin);
+        std::int64_t ready = std::max(m_full.load(std::memory_order_relaxed), now) + m_rate.cost(std::min(tokens, m_burst)) - m_tolerance;
+
+        return std::chrono::nanoseconds(std::max<std::int64_t>(ready - now, 0));
+    }
+
+    [[nodiscard]] std::size_t available() const noexcept
+    {
+        std::int64_t now = pacing::elapsed<Clock>(m_origin);
+        return m_rate.tokens(now + m_tolerance - std::max(m_full.load(std::memory_order_relaxed), now));
+    }
+
+    [[nodiscard]] std::size_t burst() const noexcept
+    {
+        return m_burst;
+    }
+
+private:
+    pacing::rate_t m_rate;
+    std::size_t m_burst;
+    std::int64_t m_tolerance;
+    typename Clock::time_point m_origin;
+    alignas(64) std::atomic<std::int64_t> m_full{0};
+};
+
+// A per-thread front for a shared token_bucket_t that takes tokens from it
+// batch at a time and hands them out without touching the shared word.
+// Cached tokens count against the bucket as soon as they are taken, so
+// every cache in use can run up to one batch ahead of the rate; leftovers
+// go back when the cache is destroyed.
+template <typename Clock = tsc_clock_t>
+class token_cache_t
+{
+public:
+    token_cache_t(token_bucket_t<Clock>& bucket, std::size_t batch) noexcept
+        : m_bucket(bucket)
+        , m_batch(batch)
+    {}
+
+    token_cache_t(const token_cache_t&) = delete;
+    token_cache_t(token_cache_t&&) = delete;
+
+    ~token_cache_t()
+    {
+        if (m_tokens != 0)
+        {
+            m_bucket.release(m_tokens);
+        }
+    }
+
+    token_cache_t& operator=(const token_cache_t&) = delete;
+    token_cache_t& operator=(token_cache_t&&) = delete;
+
+    bool try_acquire(std::size_t tokens = 1) noexcept
+    {
+        if (m_tokens < tokens)
+        {
+            m_tokens += m_bucket.acquire_up_to(std::max(m_batch, tokens - m_tokens));
+
+            if (m_tokens < tokens)
+            {
+                return false;
+            }
+        }
+
+        m_tokens -= tokens;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t cached() const noexcept
+    {
+        return m_tokens;
+    }
+
+private:
+    token_bucket_t<Clock>& m_bucket;
+    std::size_t m_batch;
+    std::size_t m_tokens = 0;
+};
+
+// A leaky bucket that lets work out at a steady rate with no bursts. Each
+// schedule() call joins the queue and is told how long to wait before its
+// units may leave; calls that would push the queue beyond capacity units
+// are turned away. Shares the single-word scheme of token_bucket_t.
+template <typename Clock = tsc_clock_t>
+class leaky_bucket_t
+{
+public:
+    using clock_type = Clock;
+
+    leaky_bucket_t(double units_per_second, std::size_t capacity) noexcept
+        : m_rate(units_per_second)
+        , m_capacity(m_rate.cost(capacity))
+        , m_origin(Clock::now())
+    {}
+
+    leaky_bucket_t(const leaky_bucket_t&) = delete;
+    leaky_bucket_t(leaky_bucket_t&&) = delete;
+
+    ~leaky_bucket_t() = default;
+
+    leaky_bucket_t& operator=(const leaky_bucket_t&) = delete;
+    leaky_bucket_t& operator=(leaky_bucket_t&&) = delete;
+
+    [[nodiscard]] maybe_t<std::chrono::nanoseconds> schedule(std::size_t units = 1) noexcept
+    {
+        std::int64_t now = pacing::elapsed<Clock>(m_origin);
+        std::int64_t drained = m_drained.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            std::int64_t start = std::max(drained, now);
+            std::int64_t next = start + m_rate.cost(units);
+
+            if (next - now > m_capacity)
+            {
+                return utils::nothing;
+            }
+
+            if (m_drained.compare_exchange_weak(drained, next, std::memory_order_relaxed))
+            {
+                return std::chrono::nanoseconds(start - now);
+            }
+        }
+    }
+
+    /// Units currently queued and not yet let out.
+    [[nodiscard]] std::size_t queued() const noexcept
+    {
+        return m_rate.tokens(m_drained.load(std::memory_order_relaxed) - pacing::elapsed<Clock>(m_origin));
+    }
+
+private:
+    pacing::rate_t m_rate;
+    std::int64_t m_capacity;
+    typename Clock::time_point m_origin;
+    alignas(64) std::atomic<std::int64_t> m_drained{0};
+};
+
+#endif  // RATE_LIMITER_HPP
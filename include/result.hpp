@@ -7,6 +7,9 @@
 #include "either.hpp"
 
 /// \cond
+#include <cstddef>
+#include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -33,7 +36,8 @@ public:
     using const_reference = const value_type&;
 
     template <typename... Args>
-    explicit success_t(Args... args)
+        requires(std::is_constructible_v<T, Args...>)
+    explicit constexpr success_t(Args&&... args)
         : m_storage(std::forward<Args>(args)...)
     {}
 
@@ -70,7 +74,8 @@ public:
     using const_reference = const value_type&;
 
     template <typename... Args>
-    explicit fail_t(Args... args)
+        requires(std::is_constructible_v<T, Args...>)
+    explicit constexpr fail_t(Args&&... args)
         : m_storage(std::forward<Args>(args)...)
     {}
 
@@ -98,6 +103,27 @@ private:
     value_type m_storage;
 };
 
+// The constructor arguments of a success_t or fail_t payload, held by
+// reference until a result_t builds the payload from them in place. It is
+// meant to be returned immediately, as in
+// `return emplace_success<Record>(name, score);`.
+template <typename Wrapper, typename... Args>
+class emplace_t
+{
+public:
+    explicit constexpr emplace_t(Args&&... args) noexcept
+        : m_arguments(std::forward<Args>(args)...)
+    {}
+
+    constexpr std::tuple<Args&&...>& arguments() noexcept
+    {
+        return m_arguments;
+    }
+
+private:
+    std::tuple<Args&&...> m_arguments;
+};
+
 template <typename Value, typename Error, typename = void>
 class result_t;
 
@@ -106,8 +132,8 @@ class result_t<Value, Error, std::enable_if_t<!std::is_void_v<Value>>>
 {
     using storage_type = either_t<Value, Error>;
 
-    static constexpr auto value = storage_type::left;
-    static constexpr auto error = storage_type::right;
+    static constexpr auto value_slot = storage_type::left;
+    static constexpr auto error_slot = storage_type::right;
 
 public:
     using value_type = Value;
@@ -115,16 +141,38 @@ public:
 
     // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
     constexpr result_t(success_t<value_type> item)
-        : m_storage(value, std::move(*item))
+        : m_storage(value_slot, std::move(*item))
         , m_has_value(true)
     {}
 
     // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
     constexpr result_t(fail_t<error_type> item)
-        : m_storage(error, std::move(*item))
+        : m_storage(error_slot, std::move(*item))
         , m_has_value(false)
     {}
 
+    template <typename... Args>
+    explicit constexpr result_t(std::in_place_type_t<success_t<value_type>> /* unused */, Args&&... args)
+        : m_storage(value_slot, std::forward<Args>(args)...)
+        , m_has_value(true)
+    {}
+
+    template <typename... Args>
+    explicit constexpr result_t(std::in_place_type_t<fail_t<error_type>> /* unused */, Args&&... args)
+        : m_storage(error_slot, std::forward<Args>(args)...)
+        , m_has_value(false)
+    {}
+
+    template <typename... Args>
+    constexpr result_t(emplace_t<success_t<value_type>, Args...> item)  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        : result_t(unpack_t{}, std::in_place_type<success_t<value_type>>, item.arguments(), std::index_sequence_for<Args...>{})
+    {}
+
+    template <typename... Args>
+    constexpr result_t(emplace_t<fail_t<error_type>, Args...> item)  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        : result_t(unpack_t{}, std::in_place_type<fail_t<error_type>>, item.arguments(), std::index_sequence_for<Args...>{})
+    {}
+
     constexpr result_t(const result_t& that) = delete;
     constexpr result_t(result_t&& that) = delete;
 
@@ -133,11 +181,11 @@ public:
     {
         if (m_has_value)
         {
-            m_storage.destruct(value);
+            m_storage.destruct(value_slot);
         }
         else
         {
-            m_storage.destruct(error);
+            m_storage.destruct(error_slot);
         }
     }
 
@@ -149,12 +197,90 @@ public:
         return m_has_value;
     }
 
-    explicit operator bool() const noexcept
+    explicit constexpr operator bool() const noexcept
     {
         return m_has_value;
     }
 
+    constexpr value_type& value() & noexcept
+    {
+        return m_storage.get(value_slot);
+    }
+
+    [[nodiscard]] constexpr const value_type& value() const& noexcept
+    {
+        return m_storage.get(value_slot);
+    }
+
+    constexpr value_type&& value() && noexcept
+    {
+        return std::move(m_storage.get(value_slot));
+    }
+
+    [[nodiscard]] constexpr const value_type&& value() const&& noexcept
+    {
+        return std::move(m_storage.get(value_slot));
+    }
+
+    constexpr error_type& error() & noexcept
+    {
+        return m_storage.get(error_slot);
+    }
+
+    [[nodiscard]] constexpr const error_type& error() const& noexcept
+    {
+        return m_storage.get(error_slot);
+    }
+
+    constexpr error_type&& error() && noexcept
+    {
+        return std::move(m_storage.get(error_slot));
+    }
+
+    [[nodiscard]] constexpr const error_type&& error() const&& noexcept
+    {
+        return std::move(m_storage.get(error_slot));
+    }
+
+    constexpr value_type& operator*() & noexcept
+    {
+        return this->value();
+    }
+
+    constexpr const value_type& operator*() const& noexcept
+    {
+        return this->value();
+    }
+
+    constexpr value_type&& operator*() && noexcept
+    {
+        return std::move(*this).value();
+    }
+
+    constexpr const value_type&& operator*() const&& noexcept
+    {
+        return std::move(*this).value();
+    }
+
+    constexpr value_type* operator->() noexcept
+    {
+        return std::addressof(this->value());
+    }
+
+    constexpr const value_type* operator->() const noexcept
+    {
+        return std::addressof(this->value());
+    }
+
 private:
+    struct unpack_t
+    {};
+
+    template <typename Tag, typename Arguments, std::size_t... I>
+    constexpr result_t(unpack_t /* unused */, Tag tag, Arguments& arguments, std::index_sequence<I...> /* unused */)
+        : result_t(tag, std::get<I>(std::move(arguments))...)
+    {}
+
     storage_type m_storage;
     bool m_has_value;
 };
@@ -164,7 +290,7 @@ class result_t<Value, Error, std::enable_if_t<std::is_void_v<Value>>>
 {
     using storage_type = either_t<Error>;
 
-    static constexpr auto error = storage_type::left;
+    static constexpr auto error_slot = storage_type::left;
 
 public:
     using value_type = Value;
@@ -182,10 +308,21 @@ public:
 
     // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
     constexpr result_t(fail_t<error_type> item)
-        : m_storage(error, std::move(*item))
+        : m_storage(error_slot, std::move(*item))
+        , m_has_value(false)
+    {}
+
+    template <typename... Args>
+    explicit constexpr result_t(std::in_place_type_t<fail_t<error_type>> /* unused */, Args&&... args)
+        : m_storage(error_slot, std::forward<Args>(args)...)
         , m_has_value(false)
     {}
 
+    template <typename... Args>
+    constexpr result_t(emplace_t<fail_t<error_type>, Args...> item)  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+        : result_t(unpack_t{}, std::in_place_type<fail_t<error_type>>, item.arguments(), std::index_sequence_for<Args...>{})
+    {}
+
     constexpr result_t(const result_t& that) = delete;
     constexpr result_t(result_t&& that) = delete;
 
@@ -194,7 +331,7 @@ public:
     {
         if (!m_has_value)
         {
-            m_storage.destruct(error);
+            m_storage.destruct(error_slot);
         }
     }
 
@@ -206,12 +343,40 @@ public:
         return m_has_value;
     }
 
-    explicit operator bool() const noexcept
+    explicit constexpr operator bool() const noexcept
     {
         return m_has_value;
     }
 
+    constexpr error_type& error() & noexcept
+    {
+        return m_storage.get(error_slot);
+    }
+
+    [[nodiscard]] constexpr const error_type& error() const& noexcept
+    {
+        return m_storage.get(error_slot);
+    }
+
+    constexpr error_type&& error() && noexcept
+    {
+        return std::move(m_storage.get(error_slot));
+    }
+
+    [[nodiscard]] constexpr const error_type&& error() const&& noexcept
+    {
+        return std::move(m_storage.get(error_slot));
+    }
+
 private:
+    struct unpack_t
+    {};
+
+    template <typename Tag, typename Arguments, std::size_t... I>
+    constexpr result_t(unpack_t /* unused */, Tag tag, Arguments& arguments, std::index_sequence<I...> /* unused */)
+        : result_t(tag, std::get<I>(std::move(arguments))...)
+    {}
+
     storage_type m_storage;
     bool m_has_value;
 };
@@ -222,6 +387,21 @@ success_t(T) -> success_t<T>;
 template <typename T>
 fail_t(T) -> fail_t<T>;
 
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+template <typename T, typename... Args>
+constexpr emplace_t<success_t<T>, Args...> emplace_success(Args&&... args) noexcept
+{
+    return emplace_t<success_t<T>, Args...>(std::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+constexpr emplace_t<fail_t<T>, Args...> emplace_fail(Args&&... args) noexcept
+{
+    return emplace_t<fail_t<T>, Args...>(std::forward<Args>(args)...);
+}
+
 #undef RESULT_CONSTEXPR_DESTRUCTOR
 
 #endif  // RESULT_HPP
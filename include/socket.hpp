@@ -4,35 +4,166 @@
 /*****************************************************************************/
 /*** HEADER INCLUDES *********************************************************/
 
-#include <arpa/inet.h>
+#include "cancellation.hpp"
+#include "cpu.hpp"
+#include "endpoint.hpp"
+#include "rate_limiter.hpp"
+#include "result.hpp"
+
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
 #include <sys/socket.h>
 
+#include <fcntl.h>
+#include <limits.h>
 #include <poll.h>
+#include <time.h>
 #include <unistd.h>
 
 /// \cond
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
-#include <optional>
+#include <span>
 #include <string_view>
-#include <tuple>
+#include <system_error>
+#include <thread>
+#include <utility>
 
 /// \endcond
 
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+using io_result_t = result_t<std::size_t, std::errc>;
+using status_result_t = result_t<void, std::errc>;
+
+/// Software timestamps taken by the kernel, on the CLOCK_REALTIME scale.
+using kernel_time_t = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+
+struct received_t
+{
+    std::size_t bytes;
+    maybe_t<kernel_time_t> kernel_time;
+};
+
+struct tx_timestamp_t
+{
+    /// Byte offset of the last byte of the send this timestamp belongs to.
+    uint32_t id;
+    kernel_time_t kernel_time;
+};
+
+/// Receive policy trading CPU for latency: spin on non-blocking reads for up
+/// to spin, then block in poll for at most timeout milliseconds (-1 waits
+/// forever) and fail with timed_out when it expires.
+struct busy_poll_t
+{
+    std::chrono::nanoseconds spin;
+    int timeout = -1;
+};
+
+/// A TCP_INFO snapshot plus the socket queue depths.
+struct tcp_stats_t
+{
+    std::chrono::microseconds rtt;
+    std::chrono::microseconds rtt_variance;
+    std::chrono::microseconds min_rtt;
+    uint32_t retransmits;
+    uint32_t lost;
+    uint32_t unacked;
+    uint32_t congestion_window;
+    uint64_t bytes_sent;
+    uint64_t bytes_acked;
+    uint64_t bytes_received;
+    uint64_t bytes_retransmitted;
+    uint32_t send_queue;
+    uint32_t not_sent;
+    uint32_t receive_queue;
+};
+
 /*****************************************************************************/
 /*** CLASSES *****************************************************************/
 
+// Every operation reports errno as std::errc instead of dropping it. recv
+// returns 0 bytes at end of stream, std::errc::operation_would_block when a
+// non-blocking socket has nothing to read, and any other code for hard
+// errors. Interrupted calls are retried.
+//
+// The blocking operations also take a cancel_token_t, which bounds them: they
+// wait in poll alongside the token's eventfd and fail with
+// std::errc::operation_canceled or std::errc::timed_out when it fires.
 class socket_t
 {
     static constexpr int default_backlog_length = 128;
+    static constexpr std::size_t max_descriptors = 16;
+
+    // glibc's tcp_info stops at tcpi_total_retrans; the kernel appends the
+    // byte counters read below. Kernels that predate a field leave it zero.
+    struct tcp_info_t
+    {
+        tcp_info base;
+        uint64_t pacing_rate;
+        uint64_t max_pacing_rate;
+        uint64_t bytes_acked;
+        uint64_t bytes_received;
+        uint32_t segs_out;
+        uint32_t segs_in;
+        uint32_t notsent_bytes;
+        uint32_t min_rtt;
+        uint32_t data_segs_in;
+        uint32_t data_segs_out;
+        uint64_t delivery_rate;
+        uint64_t busy_time;
+        uint64_t rwnd_limited;
+        uint64_t sndbuf_limited;
+        uint32_t delivered;
+        uint32_t delivered_ce;
+        uint64_t bytes_sent;
+        uint64_t bytes_retrans;
+    };
 
 public:
     socket_t()
         : m_descriptor(::socket(AF_INET, SOCK_STREAM, 0))
     {}
 
+    /// AF_INET6 sockets are created dual-stack, so they also reach IPv4
+    /// peers through mapped addresses.
+    socket_t(int domain, int type)
+        : m_descriptor(::socket(domain, type | SOCK_CLOEXEC, 0))
+    {
+        if (domain == AF_INET6)
+        {
+            int disable = 0;
+            ::setsockopt(m_descriptor, IPPROTO_IPV6, IPV6_V6ONLY, &disable, sizeof(disable));
+        }
+    }
+
+    explicit socket_t(const endpoint_t& endpoint, int type = SOCK_STREAM)
+        : socket_t(endpoint.family(), type)
+    {}
+
+    [[nodiscard]] static result_t<std::pair<socket_t, socket_t>, std::errc> pair(int type = SOCK_STREAM)
+    {
+        int descriptors[2] = {-1, -1};
+
+        if (::socketpair(AF_UNIX, type | SOCK_CLOEXEC, 0, descriptors) == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        return success_t<std::pair<socket_t, socket_t>>(socket_t(descriptors[0]), socket_t(descriptors[1]));
+    }
+
     socket_t(socket_t&& that) noexcept
         : m_descriptor(that.m_descriptor)
     {
@@ -43,6 +174,8 @@ public:
     {
         if (this != std::addressof(that))
         {
+            this->close();
+
             this->m_descriptor = that.m_descriptor;
             that.m_descriptor = -1;
         }
@@ -58,114 +191,676 @@ public:
     socket_t(const socket_t& /* that */) = delete;
     socket_t& operator=(const socket_t& /* that */) = delete;
 
-    void bind(std::string_view addr, uint16_t port) const
+    [[nodiscard]] bool is_open() const noexcept
     {
-        sockaddr_in socket{};
+        return m_descriptor != -1;
+    }
 
-        socket.sin_family = AF_INET;
-        socket.sin_port = htons(port);
+    [[nodiscard]] status_result_t bind(std::string_view addr, uint16_t port) const
+    {
+        auto endpoint = endpoint_t::parse(addr, port);
 
-        // NOLINTNEXTLINE(bugprone-suspicious-stringview-data-usage)
-        ::inet_pton(AF_INET, addr.data(), &socket.sin_addr);
+        if (!endpoint.has_value())
+        {
+            return fail_t<std::errc>(std::errc::invalid_argument);
+        }
 
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        auto* sock_addr = reinterpret_cast<sockaddr*>(&socket);
+        return bind(*endpoint);
+    }
 
-        int enable = 1;
+    [[nodiscard]] status_result_t bind(const endpoint_t& endpoint) const
+    {
+        if (endpoint.family() != AF_UNIX)
+        {
+            int enable = 1;
 
-        ::setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
-        ::setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+            ::setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+            ::setsockopt(m_descriptor, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+        }
 
-        std::ignore = ::bind(m_descriptor, sock_addr, sizeof(socket));
+        return status(::bind(m_descriptor, endpoint.data(), endpoint.size()));
     }
 
-    void listen(int backlog = default_backlog_length) const
+    [[nodiscard]] status_result_t listen(int backlog = default_backlog_length) const
     {
-        std::ignore = ::listen(m_descriptor, backlog);
+        return status(::listen(m_descriptor, backlog));
     }
 
-    [[nodiscard]] socket_t accept() const
+    [[nodiscard]] result_t<socket_t, std::errc> accept() const
     {
-        sockaddr_in socket{};
-        socklen_t socket_length = sizeof(socket);
+        int descriptor = -1;
 
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        auto* socket_addr = reinterpret_cast<sockaddr*>(&socket);
+        do
+        {
+            descriptor = ::accept4(m_descriptor, nullptr, nullptr, SOCK_CLOEXEC);
+        } while (descriptor == -1 && errno == EINTR);
 
-        return socket_t(::accept(m_descriptor, socket_addr, &socket_length));
+        if (descriptor == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        return success_t<socket_t>(socket_t(descriptor));
     }
 
-    void connect(std::string_view addr, uint16_t port) const
+    /// Waits for a connection under token. The listener has to be
+    /// non-blocking, see set_nonblocking(): a connection another thread
+    /// takes between the wakeup and accept4 would otherwise leave this call
+    /// blocked with no bound. A blocking listener fails with
+    /// std::errc::invalid_argument. The listener's flags are left alone,
+    /// since other threads may be accepting on it.
+    [[nodiscard]] result_t<socket_t, std::errc> accept(const cancel_token_t& token) const
     {
-        sockaddr_in socket{};
+        int flags = ::fcntl(m_descriptor, F_GETFL);
+
+        if (flags == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
 
-        socket.sin_family = AF_INET;
-        socket.sin_port = htons(port);
+        if ((flags & O_NONBLOCK) == 0)
+        {
+            return fail_t<std::errc>(std::errc::invalid_argument);
+        }
+
+        if (token.cancelled())
+        {
+            return fail_t<std::errc>(std::errc::operation_canceled);
+        }
 
-        // NOLINTNEXTLINE(bugprone-suspicious-stringview-data-usage)
-        ::inet_pton(AF_INET, addr.data(), &socket.sin_addr);
+        for (;;)
+        {
+            int descriptor = ::accept4(m_descriptor, nullptr, nullptr, SOCK_CLOEXEC);
+
+            if (descriptor != -1)
+            {
+                return success_t<socket_t>(socket_t(descriptor));
+            }
+
+            if (errno != EAGAIN && errno != EINTR && errno != ECONNABORTED)
+            {
+                return fail_t<std::errc>(last_error());
+            }
+
+            if (auto ready = token.wait(m_descriptor, POLLIN); !ready)
+            {
+                return fail_t<std::errc>(ready.error());
+            }
+        }
+    }
+
+    [[nodiscard]] status_result_t connect(std::string_view addr, uint16_t port) const
+    {
+        auto endpoint = endpoint_t::parse(addr, port);
+
+        if (!endpoint.has_value())
+        {
+            return fail_t<std::errc>(std::errc::invalid_argument);
+        }
+
+        return connect(*endpoint);
+    }
+
+    [[nodiscard]] status_result_t connect(const endpoint_t& endpoint) const
+    {
+        return status(::connect(m_descriptor, endpoint.data(), endpoint.size()));
+    }
+
+    /// Connects without blocking and waits for the handshake under token. A
+    /// socket whose connect was cancelled or timed out should be discarded.
+    [[nodiscard]] status_result_t connect(const endpoint_t& endpoint, const cancel_token_t& token) const
+    {
+        int flags = ::fcntl(m_descriptor, F_GETFL);
+
+        if (flags == -1 || ::fcntl(m_descriptor, F_SETFL, flags | O_NONBLOCK) == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        int error = ::connect(m_descriptor, endpoint.data(), endpoint.size()) == -1 ? errno : 0;
+
+        if (error == EINPROGRESS || error == EINTR)
+        {
+            auto ready = token.wait(m_descriptor, POLLOUT);
+
+            if (!ready)
+            {
+                ::fcntl(m_descriptor, F_SETFL, flags);
+                return fail_t<std::errc>(ready.error());
+            }
+
+            socklen_t length = sizeof(error);
+            ::getsockopt(m_descriptor, SOL_SOCKET, SO_ERROR, &error, &length);
+        }
+
+        ::fcntl(m_descriptor, F_SETFL, flags);
+
+        if (error != 0)
+        {
+            return fail_t<std::errc>(static_cast<std::errc>(error));
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] status_result_t bind_local(std::string_view path) const
+    {
+        auto endpoint = endpoint_t::local(path);
+
+        if (!endpoint.has_value())
+        {
+            return fail_t<std::errc>(std::errc::filename_too_long);
+        }
+
+        return bind(*endpoint);
+    }
+
+    [[nodiscard]] status_result_t connect_local(std::string_view path) const
+    {
+        auto endpoint = endpoint_t::local(path);
+
+        if (!endpoint.has_value())
+        {
+            return fail_t<std::errc>(std::errc::filename_too_long);
+        }
+
+        return connect(*endpoint);
+    }
+
+    [[nodiscard]] int descriptor() const noexcept
+    {
+        return m_descriptor;
+    }
+
+    /// The address the socket is bound to, with the port the kernel picked
+    /// if it was bound to port 0.
+    [[nodiscard]] result_t<endpoint_t, std::errc> local_endpoint() const
+    {
+        sockaddr_storage storage{};
+        socklen_t length = sizeof(storage);
 
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        auto* socket_addr = reinterpret_cast<sockaddr*>(&socket);
+        if (::getsockname(m_descriptor, reinterpret_cast<sockaddr*>(&storage), &length) == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
 
-        std::ignore = ::connect(m_descriptor, socket_addr, sizeof(socket));
+        return success_t<endpoint_t>(endpoint_t::from(storage, length));
+    }
+
+    [[nodiscard]] status_result_t shutdown(int how = SHUT_RDWR) const
+    {
+        return status(::shutdown(m_descriptor, how));
     }
 
     void close()
     {
         if (m_descriptor != -1)
         {
-            ::shutdown(m_descriptor, AF_INET);
             ::close(m_descriptor);
 
             m_descriptor = -1;
         }
     }
 
-    [[nodiscard]] std::optional<std::size_t> send(std::string_view message) const
+    [[nodiscard]] io_result_t send(std::string_view message) const
     {
         return send(message.data(), message.length());
     }
 
-    [[nodiscard]] std::optional<std::size_t> send(const void* data, std::size_t length) const
+    [[nodiscard]] io_result_t send(const void* data, std::size_t length) const
+    {
+        ssize_t result = 0;
+
+        do
+        {
+            result = ::send(m_descriptor, data, length, MSG_NOSIGNAL);
+        } while (result == -1 && errno == EINTR);
+
+        return transferred(result);
+    }
+
+    [[nodiscard]] io_result_t send(const void* data, std::size_t length, const cancel_token_t& token) const
+    {
+        return until_ready(token, POLLOUT, [&]() {
+            return ::send(m_descriptor, data, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+        });
+    }
+
+    [[nodiscard]] io_result_t send(std::string_view message, const cancel_token_t& token) const
+    {
+        return send(message.data(), message.length(), token);
+    }
+
+    /// Sends no more than pacer grants, sleeping until it refills when it is
+    /// empty. Granted bytes the kernel does not take are handed back, so the
+    /// bucket paces bytes actually sent.
+    template <typename Clock>
+    [[nodiscard]] io_result_t send(const void* data, std::size_t length, token_bucket_t<Clock>& pacer) const
+    {
+        std::size_t granted = length == 0 ? 0 : pacer.acquire_up_to(length);
+
+        while (granted == 0 && length != 0)
+        {
+            std::this_thread::sleep_for(pacer.wait_time(length));
+            granted = pacer.acquire_up_to(length);
+        }
+
+        auto result = send(data, granted);
+        std::size_t sent = result ? *result : 0;
+
+        if (sent < granted)
+        {
+            pacer.release(granted - sent);
+        }
+
+        if (!result)
+        {
+            return fail_t<std::errc>(result.error());
+        }
+
+        return success_t<std::size_t>(sent);
+    }
+
+    template <typename Clock>
+    [[nodiscard]] io_result_t send(std::string_view message, token_bucket_t<Clock>& pacer) const
+    {
+        return send(message.data(), message.length(), pacer);
+    }
+
+    /// Gathers the vectors into a single sendmsg; at most IOV_MAX are sent.
+    [[nodiscard]] io_result_t send(std::span<const iovec> vectors) const
+    {
+        msghdr message{};
+
+        message.msg_iov = const_cast<iovec*>(vectors.data());  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+        message.msg_iovlen = std::min<std::size_t>(vectors.size(), IOV_MAX);
+
+        ssize_t result = 0;
+
+        do
+        {
+            result = ::sendmsg(m_descriptor, &message, MSG_NOSIGNAL);
+        } while (result == -1 && errno == EINTR);
+
+        return transferred(result);
+    }
+
+    [[nodiscard]] io_result_t recv(void* data, std::size_t length) const
+    {
+        ssize_t result = 0;
+
+        do
+        {
+            result = ::recv(m_descriptor, data, length, 0);
+        } while (result == -1 && errno == EINTR);
+
+        return transferred(result);
+    }
+
+    [[nodiscard]] io_result_t recv(void* data, std::size_t length, const cancel_token_t& token) const
+    {
+        return until_ready(token, POLLIN, [&]() {
+            return ::recv(m_descriptor, data, length, MSG_DONTWAIT);
+        });
+    }
+
+    [[nodiscard]] io_result_t recv(void* data, std::size_t length, const busy_poll_t& policy) const
     {
-        auto result = ::send(m_descriptor, data, length, 0);
+        static constexpr int clock_stride = 64;
+
+        auto deadline = std::chrono::steady_clock::now() + policy.spin;
+
+        for (int spins = 0;; ++spins)
+        {
+            auto result = ::recv(m_descriptor, data, length, MSG_DONTWAIT);
+
+            if (result != -1 || (errno != EAGAIN && errno != EINTR))
+            {
+                return transferred(result);
+            }
+
+            if (spins % clock_stride == 0 && std::chrono::steady_clock::now() >= deadline)
+            {
+                break;
+            }
+
+            cpu_t::relax();
+        }
+
+        // Interrupted and spurious wakeups poll again for what is left, so
+        // the wait stays bounded by timeout.
+        auto limit = std::chrono::steady_clock::now() + std::chrono::milliseconds(policy.timeout);
+
+        for (;;)
+        {
+            int remaining = policy.timeout;
+
+            if (policy.timeout >= 0)
+            {
+                auto left = std::chrono::ceil<std::chrono::milliseconds>(limit - std::chrono::steady_clock::now());
+                remaining = static_cast<int>(std::max<std::chrono::milliseconds::rep>(left.count(), 0));
+            }
+
+            auto ready = pool(remaining);
+
+            if (!ready && ready.error() == std::errc::interrupted)
+            {
+                continue;
+            }
+
+            if (!ready)
+            {
+                return fail_t<std::errc>(ready.error());
+            }
+
+            if (*ready == 0)
+            {
+                return fail_t<std::errc>(std::errc::timed_out);
+            }
+
+            auto result = ::recv(m_descriptor, data, length, MSG_DONTWAIT);
+
+            if (result != -1 || (errno != EAGAIN && errno != EINTR))
+            {
+                return transferred(result);
+            }
+        }
+    }
+
+    /// Switches the socket between blocking and non-blocking mode. The mode
+    /// belongs to the open socket, so it applies to every duplicate of the
+    /// descriptor as well.
+    [[nodiscard]] status_result_t set_nonblocking(bool enable = true) const
+    {
+        int flags = ::fcntl(m_descriptor, F_GETFL);
+
+        if (flags == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        return status(::fcntl(m_descriptor, F_SETFL, enable ? flags | O_NONBLOCK : flags & ~O_NONBLOCK));
+    }
+
+    /// Lets the kernel busy-poll the device queue for up to the given time
+    /// on blocking reads (SO_BUSY_POLL); raising it may need CAP_NET_ADMIN.
+    [[nodiscard]] status_result_t set_busy_poll(std::chrono::microseconds duration) const
+    {
+        auto value = static_cast<int>(duration.count());
+        return status(::setsockopt(m_descriptor, SOL_SOCKET, SO_BUSY_POLL, &value, sizeof(value)));
+    }
+
+    [[nodiscard]] io_result_t send_descriptors(std::span<const int> descriptors, const void* data, std::size_t length) const
+    {
+        if (descriptors.size() > max_descriptors)
+        {
+            return fail_t<std::errc>(std::errc::argument_list_too_long);
+        }
+
+        char placeholder = 0;
+        iovec vector{const_cast<void*>(data), length};  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+
+        if (length == 0)
+        {
+            vector = iovec{&placeholder, 1};
+        }
+
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * max_descriptors)]{};
+
+        msghdr message{};
+
+        message.msg_iov = &vector;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * descriptors.size());
+
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int) * descriptors.size());
+
+        std::memcpy(CMSG_DATA(header), descriptors.data(), sizeof(int) * descriptors.size());
+
+        ssize_t result = 0;
+
+        do
+        {
+            result = ::sendmsg(m_descriptor, &message, MSG_NOSIGNAL);
+        } while (result == -1 && errno == EINTR);
+
+        return transferred(length == 0 && result != -1 ? 0 : result);
+    }
+
+    /// Yields the payload byte count and the number of descriptors stored
+    /// into the span; descriptors that do not fit are closed.
+    [[nodiscard]] result_t<std::pair<std::size_t, std::size_t>, std::errc> recv_descriptors(std::span<int> descriptors, void* data, std::size_t length) const
+    {
+        char placeholder = 0;
+        iovec vector{data, length};
+
+        if (length == 0)
+        {
+            vector = iovec{&placeholder, 1};
+        }
+
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * max_descriptors)]{};
+
+        msghdr message{};
+
+        message.msg_iov = &vector;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        ssize_t result = 0;
+
+        do
+        {
+            result = ::recvmsg(m_descriptor, &message, MSG_CMSG_CLOEXEC);
+        } while (result == -1 && errno == EINTR);
 
         if (result == -1)
         {
-            return std::nullopt;
+            return fail_t<std::errc>(last_error());
         }
 
-        return static_cast<std::size_t>(result);
+        std::size_t received = 0;
+
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+        {
+            if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS)
+            {
+                continue;
+            }
+
+            std::size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                int descriptor = -1;
+                std::memcpy(&descriptor, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+
+                if (received < descriptors.size())
+                {
+                    descriptors[received++] = descriptor;
+                }
+                else
+                {
+                    ::close(descriptor);
+                }
+            }
+        }
+
+        auto bytes = length == 0 ? 0 : static_cast<std::size_t>(result);
+
+        return success_t<std::pair<std::size_t, std::size_t>>(bytes, received);
     }
 
-    [[nodiscard]] std::optional<std::size_t> recv(void* data, std::size_t length) const
+    [[nodiscard]] status_result_t send_socket(const socket_t& that) const
     {
-        auto result = ::recv(m_descriptor, data, length, 0);
+        int descriptor = that.m_descriptor;
 
-        if (result == 0 || result == -1)
+        if (auto result = send_descriptors(std::span(&descriptor, 1), nullptr, 0); !result)
         {
-            return std::nullopt;
+            return fail_t<std::errc>(result.error());
         }
 
-        return static_cast<std::size_t>(result);
+        return {};
     }
 
-    [[nodiscard]] std::optional<std::size_t> pool(int timeout) const
+    [[nodiscard]] result_t<socket_t, std::errc> recv_socket() const
     {
-        pollfd pfd{};
+        int descriptor = -1;
+        auto result = recv_descriptors(std::span(&descriptor, 1), nullptr, 0);
 
-        pfd.fd = m_descriptor;
-        pfd.events = POLLIN;
+        if (!result)
+        {
+            return fail_t<std::errc>(result.error());
+        }
 
-        auto result = ::poll(std::addressof(pfd), 1, timeout);
+        if (result->second == 0)
+        {
+            return fail_t<std::errc>(std::errc::bad_message);
+        }
+
+        return success_t<socket_t>(socket_t(descriptor));
+    }
+
+    /// Opts into software receive timestamps and, with transmit set, send
+    /// timestamps queued on the error queue (see recv_tx_timestamp).
+    [[nodiscard]] status_result_t enable_timestamps(bool transmit = true) const
+    {
+        unsigned int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+
+        if (transmit)
+        {
+            flags |= SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+        }
+
+        return status(::setsockopt(m_descriptor, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)));
+    }
+
+    [[nodiscard]] result_t<received_t, std::errc> recv_timestamped(void* data, std::size_t length) const
+    {
+        iovec vector{data, length};
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(scm_timestamping))]{};
+
+        msghdr message{};
+
+        message.msg_iov = &vector;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        ssize_t result = 0;
+
+        do
+        {
+            result = ::recvmsg(m_descriptor, &message, 0);
+        } while (result == -1 && errno == EINTR);
 
         if (result == -1)
         {
-            return std::nullopt;
+            return fail_t<std::errc>(last_error());
         }
 
-        return static_cast<std::size_t>(result);
+        return success_t<received_t>(received_t{static_cast<std::size_t>(result), timestamp(message)});
+    }
+
+    /// Reads one send timestamp from the error queue; fails with
+    /// operation_would_block when none is pending.
+    [[nodiscard]] result_t<tx_timestamp_t, std::errc> recv_tx_timestamp() const
+    {
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(scm_timestamping)) + CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))]{};
+
+        msghdr message{};
+
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        if (::recvmsg(m_descriptor, &message, MSG_ERRQUEUE | MSG_DONTWAIT) == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        auto time = timestamp(message);
+        bool stamped = false;
+        uint32_t id = 0;
+
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+        {
+            bool recverr = (header->cmsg_level == SOL_IP && header->cmsg_type == IP_RECVERR)
+                        || (header->cmsg_level == SOL_IPV6 && header->cmsg_type == IPV6_RECVERR);
+
+            if (recverr)
+            {
+                sock_extended_err error{};
+                std::memcpy(&error, CMSG_DATA(header), sizeof(error));
+
+                if (error.ee_origin == SO_EE_ORIGIN_TIMESTAMPING)
+                {
+                    stamped = true;
+                    id = error.ee_data;
+                }
+            }
+        }
+
+        if (!time.has_value() || !stamped)
+        {
+            return fail_t<std::errc>(std::errc::no_message);
+        }
+
+        return success_t<tx_timestamp_t>(tx_timestamp_t{id, *time});
+    }
+
+    [[nodiscard]] result_t<tcp_stats_t, std::errc> stats() const
+    {
+        tcp_info_t info{};
+        socklen_t length = sizeof(info);
+
+        if (::getsockopt(m_descriptor, IPPROTO_TCP, TCP_INFO, &info, &length) == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        int send_queue = 0;
+        int receive_queue = 0;
+
+        if (::ioctl(m_descriptor, SIOCOUTQ, &send_queue) == -1 || ::ioctl(m_descriptor, SIOCINQ, &receive_queue) == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        tcp_stats_t stats{};
+
+        stats.rtt = std::chrono::microseconds(info.base.tcpi_rtt);
+        stats.rtt_variance = std::chrono::microseconds(info.base.tcpi_rttvar);
+        stats.min_rtt = std::chrono::microseconds(info.min_rtt);
+        stats.retransmits = info.base.tcpi_total_retrans;
+        stats.lost = info.base.tcpi_lost;
+        stats.unacked = info.base.tcpi_unacked;
+        stats.congestion_window = info.base.tcpi_snd_cwnd;
+        stats.bytes_sent = info.bytes_sent;
+        stats.bytes_acked = info.bytes_acked;
+        stats.bytes_received = info.bytes_received;
+        stats.bytes_retransmitted = info.bytes_retrans;
+        stats.send_queue = static_cast<uint32_t>(send_queue);
+        stats.not_sent = info.notsent_bytes;
+        stats.receive_queue = static_cast<uint32_t>(receive_queue);
+
+        return success_t<tcp_stats_t>(stats);
+    }
+
+    [[nodiscard]] io_result_t pool(int timeout) const
+    {
+        pollfd pfd{};
+
+        pfd.fd = m_descriptor;
+        pfd.events = POLLIN;
+
+        return transferred(::poll(std::addressof(pfd), 1, timeout));
     }
 
 private:
@@ -173,6 +868,74 @@ private:
         : m_descriptor(descriptor)
     {}
 
+    static std::errc last_error() noexcept
+    {
+        return static_cast<std::errc>(errno);
+    }
+
+    static maybe_t<kernel_time_t> timestamp(msghdr& message) noexcept
+    {
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+        {
+            if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_TIMESTAMPING)
+            {
+                scm_timestamping stamps{};
+                std::memcpy(&stamps, CMSG_DATA(header), sizeof(stamps));
+
+                auto since_epoch = std::chrono::seconds(stamps.ts[0].tv_sec) + std::chrono::nanoseconds(stamps.ts[0].tv_nsec);
+                return kernel_time_t(since_epoch);
+            }
+        }
+
+        return utils::nothing;
+    }
+
+    static status_result_t status(int result) noexcept
+    {
+        if (result == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        return {};
+    }
+
+    /// Runs a non-blocking attempt, waiting under token whenever it would
+    /// block. A cancelled token stops it before the first attempt.
+    template <typename F>
+    io_result_t until_ready(const cancel_token_t& token, short events, F&& attempt) const
+    {
+        if (token.cancelled())
+        {
+            return fail_t<std::errc>(std::errc::operation_canceled);
+        }
+
+        for (;;)
+        {
+            ssize_t result = attempt();
+
+            if (result != -1 || (errno != EAGAIN && errno != EINTR))
+            {
+                return transferred(result);
+            }
+
+            if (auto ready = token.wait(m_descriptor, events); !ready)
+            {
+                return fail_t<std::errc>(ready.error());
+            }
+        }
+    }
+
+    static io_result_t transferred(ssize_t result) noexcept
+    {
+        if (result == -1)
+        {
+            return fail_t<std::errc>(last_error());
+        }
+
+        return success_t<std::size_t>(static_cast<std::size_t>(result));
+    }
+
     int m_descriptor;
 };
 
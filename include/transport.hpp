@@ -0,0 +1,38 @@
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "socket.hpp"
+
+#include <sys/uio.h>
+
+/// \cond
+#include <concepts>
+#include <cstddef>
+#include <span>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+/// A byte stream with socket_t's results: send and recv report how many
+/// bytes moved, recv yields 0 at end of stream and a would-be-blocking
+/// non-blocking endpoint fails with std::errc::operation_would_block.
+template <typename T>
+concept transport = requires(const T& endpoint, void* data, const void* message, std::size_t length) {
+    { endpoint.send(message, length) } -> std::same_as<io_result_t>;
+    { endpoint.recv(data, length) } -> std::same_as<io_result_t>;
+};
+
+/// A transport that can also send several buffers in one call.
+template <typename T>
+concept gather_transport = transport<T> && requires(const T& endpoint, std::span<const iovec> vectors) {
+    { endpoint.send(vectors) } -> std::same_as<io_result_t>;
+};
+
+static_assert(gather_transport<socket_t>);
+
+#endif  // TRANSPORT_HPP
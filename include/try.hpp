@@ -0,0 +1,436 @@
+#ifndef TRY_HPP
+#define TRY_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "maybe.hpp"
+#include "result.hpp"
+#include "utils.hpp"
+
+/// \cond
+#include <coroutine>
+#include <type_traits>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** MACRO DEFINITIONS *******************************************************/
+
+// TRY(expr) evaluates a result_t or maybe_t and either yields its value
+// (moved out when expr is an rvalue) or returns the failure from the
+// enclosing function. Without statement expressions it falls back to
+// co_await, so the enclosing function has to be a coroutine using co_return.
+// Each expansion names its temporary after __COUNTER__, so TRY nests
+// without shadowing.
+#if defined(__GNUC__) || defined(__clang__)
+    #define TRY(...)                    TRY_WITH(TRY_NAME(try_result_, __COUNTER__), __VA_ARGS__)
+    #define TRY_NAME(prefix, counter)   TRY_CONCAT(prefix, counter)
+    #define TRY_CONCAT(prefix, counter) prefix##counter
+    #define TRY_WITH(name, ...)                                                 \
+        __extension__({                                                         \
+            auto&& name = (__VA_ARGS__);                                        \
+            if (!name.has_value()) [[unlikely]]                                 \
+            {                                                                   \
+                return propagate_failure(std::forward<decltype(name)>(name));   \
+            }                                                                   \
+            unwrap_value(std::forward<decltype(name)>(name));                   \
+        })
+#else
+    #define TRY(...) co_await (__VA_ARGS__)
+#endif  // __GNUC__ || __clang__
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+template <typename Value, typename Error>
+fail_t<Error> propagate_failure(result_t<Value, Error>&& result)
+{
+    return fail_t<Error>(std::move(result).error());
+}
+
+template <typename Value, typename Error>
+fail_t<Error> propagate_failure(const result_t<Value, Error>& result)
+{
+    return fail_t<Error>(result.error());
+}
+
+template <typename T>
+constexpr utils::nothing_t propagate_failure(const maybe_t<T>& /* unused */) noexcept
+{
+    return utils::nothing;
+}
+
+template <typename Value, typename Error>
+constexpr decltype(auto) unwrap_value(result_t<Value, Error>&& result) noexcept
+{
+    if constexpr (!std::is_void_v<Value>)
+    {
+        return std::move(result).value();
+    }
+}
+
+template <typename Value, typename Error>
+constexpr decltype(auto) unwrap_value(const result_t<Value, Error>& result) noexcept
+{
+    if constexpr (!std::is_void_v<Value>)
+    {
+        return result.value();
+    }
+}
+
+template <typename T>
+constexpr T&& unwrap_value(maybe_t<T>&& item) noexcept
+{
+    return *std::move(item);
+}
+
+template <typename T>
+constexpr const T& unwrap_value(const maybe_t<T>& item) noexcept
+{
+    return *item;
+}
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+template <typename R>
+class coroutine_outcome_t;
+
+// How a finished maybe_t coroutine hands over its result.
+template <typename T>
+class coroutine_outcome_t<maybe_t<T>>
+{
+public:
+    explicit coroutine_outcome_t(maybe_t<T> value)
+        : m_value(std::move(value))
+    {}
+
+    maybe_t<T> finish() &&
+    {
+        return std::move(m_value);
+    }
+
+private:
+    maybe_t<T> m_value;
+};
+
+// How a finished result_t coroutine hands over its result; result_t itself
+// cannot be moved, so its parts are kept and it is built on the way out.
+template <typename Value, typename Error>
+class coroutine_outcome_t<result_t<Value, Error>>
+{
+public:
+    explicit coroutine_outcome_t(fail_t<Error> error)
+        : m_error(std::move(*error))
+    {}
+
+    template <typename... Args>
+    explicit coroutine_outcome_t(utils::something_t /* unused */, Args&&... args)
+        : m_value(std::forward<Args>(args)...)
+        , m_error(utils::nothing)
+    {}
+
+    result_t<Value, Error> finish() &&
+    {
+        if (m_error.has_value())
+        {
+            return fail_t<Error>(std::move(*m_error));
+        }
+
+        if constexpr (std::is_void_v<Value>)
+        {
+            return {};
+        }
+        else
+        {
+            return success_t<Value>(std::move(*m_value));
+        }
+    }
+
+private:
+    maybe_t<std::conditional_t<std::is_void_v<Value>, bool, Value>> m_value = utils::nothing;
+    maybe_t<Error> m_error;
+};
+
+// The object handed back to the caller of a result_t/maybe_t coroutine. The
+// coroutine starts suspended and only runs when this is converted into the
+// declared return type, so the result is ready whenever the compiler chooses
+// to convert. The result is kept in the coroutine frame, which is destroyed
+// once it has been moved out.
+//
+// Failures travel in the result; an exception escaping the body terminates.
+// Rethrowing it would have to go through this conversion, and whether the
+// compiler then destroys the frame as well is left open by the standard.
+template <typename Promise, typename R>
+class coroutine_return_t
+{
+    using handle_t = std::coroutine_handle<Promise>;
+
+public:
+    explicit coroutine_return_t(Promise& promise) noexcept
+        : m_handle(handle_t::from_promise(promise))
+    {}
+
+    coroutine_return_t(const coroutine_return_t&) = delete;
+    coroutine_return_t(coroutine_return_t&&) = delete;
+
+    ~coroutine_return_t()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    coroutine_return_t& operator=(const coroutine_return_t&) = delete;
+    coroutine_return_t& operator=(coroutine_return_t&&) = delete;
+
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    operator R()
+    {
+        struct frame_t
+        {
+            explicit frame_t(handle_t frame) noexcept
+                : handle(frame)
+            {}
+
+            frame_t(const frame_t&) = delete;
+            frame_t(frame_t&&) = delete;
+
+            ~frame_t()
+            {
+                handle.destroy();
+            }
+
+            frame_t& operator=(const frame_t&) = delete;
+            frame_t& operator=(frame_t&&) = delete;
+
+            handle_t handle;
+        };
+
+        frame_t frame(std::exchange(m_handle, nullptr));
+        frame.handle.resume();
+
+        auto& promise = frame.handle.promise();
+
+        if (!promise.m_result.has_value())
+        {
+            panic("coroutine finished without a result");
+        }
+
+        return std::move(*promise.m_result).finish();
+    }
+
+private:
+    handle_t m_handle;
+};
+
+template <typename Derived, typename R>
+class coroutine_promise_t
+{
+public:
+    coroutine_return_t<Derived, R> get_return_object() noexcept
+    {
+        return coroutine_return_t<Derived, R>(static_cast<Derived&>(*this));
+    }
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    std::suspend_always final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() const noexcept
+    {
+        panic("exception escaped a result_t/maybe_t coroutine");
+    }
+
+protected:
+    template <typename... Args>
+    void set(Args&&... args)
+    {
+        m_result = maybe_t<coroutine_outcome_t<R>>(std::forward<Args>(args)...);
+    }
+
+private:
+    friend class coroutine_return_t<Derived, R>;
+
+    maybe_t<coroutine_outcome_t<R>> m_result = utils::nothing;
+};
+
+template <typename T>
+class maybe_promise_t : public coroutine_promise_t<maybe_promise_t<T>, maybe_t<T>>
+{
+public:
+    void return_value(T value)
+    {
+        this->set(maybe_t<T>(std::move(value)));
+    }
+
+    void return_value(utils::nothing_t /* unused */)
+    {
+        this->set(maybe_t<T>(utils::nothing));
+    }
+
+    template <typename Failure>
+    void fail(Failure&& /* unused */)
+    {
+        this->set(maybe_t<T>(utils::nothing));
+    }
+};
+
+template <typename Value, typename Error>
+class result_promise_t : public coroutine_promise_t<result_promise_t<Value, Error>, result_t<Value, Error>>
+{
+public:
+    void return_value(Value value)
+    {
+        this->set(utils::something, std::move(value));
+    }
+
+    void return_value(fail_t<Error> error)
+    {
+        this->set(std::move(error));
+    }
+
+    template <typename Failure>
+    void fail(Failure&& error)
+    {
+        this->set(fail_t<Error>(std::forward<Failure>(error)));
+    }
+};
+
+template <typename Error>
+class result_promise_t<void, Error> : public coroutine_promise_t<result_promise_t<void, Error>, result_t<void, Error>>
+{
+public:
+    void return_void()
+    {
+        this->set(utils::something);
+    }
+
+    template <typename Failure>
+    void fail(Failure&& error)
+    {
+        this->set(fail_t<Error>(std::forward<Failure>(error)));
+    }
+};
+
+// Hands a failure to the promise and leaves the coroutine suspended for
+// good; coroutine_return_t destroys the frame once it has the result.
+template <typename T>
+class failure_awaiter_t
+{
+public:
+    explicit failure_awaiter_t(T&& source) noexcept
+        : m_source(std::addressof(source))
+    {}
+
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+        return m_source->has_value();
+    }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        if constexpr (requires { m_source->error(); })
+        {
+            handle.promise().fail(std::forward<T>(*m_source).error());
+        }
+        else
+        {
+            handle.promise().fail(utils::nothing);
+        }
+    }
+
+    decltype(auto) await_resume() noexcept
+    {
+        return unwrap_value(std::forward<T>(*m_source));
+    }
+
+private:
+    std::remove_reference_t<T>* m_source;
+};
+
+template <typename Error>
+class fail_awaiter_t
+{
+public:
+    explicit fail_awaiter_t(fail_t<Error>&& error) noexcept
+        : m_error(std::addressof(error))
+    {}
+
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <typename Promise>
+    void await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        handle.promise().fail(std::move(**m_error));
+    }
+
+    void await_resume() const noexcept
+    {}
+
+private:
+    fail_t<Error>* m_error;
+};
+
+/*****************************************************************************/
+/*** OPERATORS ***************************************************************/
+
+template <typename Value, typename Error>
+failure_awaiter_t<result_t<Value, Error>&&> operator co_await(result_t<Value, Error>&& result) noexcept
+{
+    return failure_awaiter_t<result_t<Value, Error>&&>(std::move(result));
+}
+
+template <typename Value, typename Error>
+failure_awaiter_t<const result_t<Value, Error>&> operator co_await(const result_t<Value, Error>& result) noexcept
+{
+    return failure_awaiter_t<const result_t<Value, Error>&>(result);
+}
+
+template <typename T>
+failure_awaiter_t<maybe_t<T>&&> operator co_await(maybe_t<T>&& item) noexcept
+{
+    return failure_awaiter_t<maybe_t<T>&&>(std::move(item));
+}
+
+template <typename T>
+failure_awaiter_t<const maybe_t<T>&> operator co_await(const maybe_t<T>& item) noexcept
+{
+    return failure_awaiter_t<const maybe_t<T>&>(item);
+}
+
+template <typename Error>
+fail_awaiter_t<Error> operator co_await(fail_t<Error>&& error) noexcept
+{
+    return fail_awaiter_t<Error>(std::move(error));
+}
+
+/*****************************************************************************/
+/*** TEMPLATE SPECIALIZATIONS ************************************************/
+
+template <typename T, typename... Args>
+struct std::coroutine_traits<maybe_t<T>, Args...>
+{
+    using promise_type = maybe_promise_t<T>;
+};
+
+template <typename Value, typename Error, typename... Args>
+struct std::coroutine_traits<result_t<Value, Error>, Args...>
+{
+    using promise_type = result_promise_t<Value, Error>;
+};
+
+#endif  // TRY_HPP
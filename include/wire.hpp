@@ -0,0 +1,748 @@
+#ifndef WIRE_HPP
+#define WIRE_HPP
+
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include "either.hpp"
+#include "maybe.hpp"
+#include "result.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TYPE DEFINITIONS ********************************************************/
+
+enum class wire_error_t
+{
+    truncated,
+    malformed,
+    buffer_too_small,
+    too_large
+};
+
+template <typename T>
+class wire_view_t;
+
+/*****************************************************************************/
+/*** FUNCTION DEFINITIONS ****************************************************/
+
+namespace wire
+{
+    using length_type = std::uint32_t;
+
+    inline constexpr std::size_t max_fields = 16;
+
+    template <typename T>
+    inline constexpr bool is_result_v = false;
+
+    template <typename Value, typename Error>
+    inline constexpr bool is_result_v<result_t<Value, Error>> = true;
+
+    template <typename T>
+    inline constexpr bool is_either_v = false;
+
+    template <typename Left, typename Right>
+    inline constexpr bool is_either_v<either_t<Left, Right>> = true;
+
+    template <typename T>
+    inline constexpr bool is_scalar_v = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+    template <typename T>
+    inline constexpr bool is_text_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+    template <typename T>
+    inline constexpr bool is_record_v = std::is_class_v<T> && std::is_aggregate_v<T> && !is_text_v<T>;
+
+    template <typename T>
+    inline constexpr bool is_flagged_v = is_maybe_v<T> || is_result_v<T>;
+
+    // Stands in for any field while counting the initializers an aggregate
+    // accepts. It is passed as a non-const lvalue so that a converting
+    // constructor taking it by forwarding reference, like maybe_t's, wins
+    // over the const conversion operator instead of being ambiguous with it.
+    struct any_field_t
+    {
+        template <typename U>
+        operator U() const;  // NOLINT(google-explicit-constructor, hicpp-explicit-conversions)
+    };
+
+    template <typename T, std::size_t... I>
+    constexpr bool brace_constructible(std::index_sequence<I...> /* unused */)
+    {
+        return requires { T{(static_cast<void>(I), std::declval<any_field_t&>())...}; };
+    }
+
+    template <typename T, std::size_t N = max_fields>
+    constexpr std::size_t field_count()
+    {
+        if constexpr (N == 0 || brace_constructible<T>(std::make_index_sequence<N>{}))
+        {
+            return N;
+        }
+        else
+        {
+            return field_count<T, N - 1>();
+        }
+    }
+
+    template <std::size_t N, typename T>
+    constexpr auto tie_fields(T& record)
+    {
+        static_assert(N != 0 && N <= max_fields, "records need between one and max_fields fields");
+
+        if constexpr (N == 1)
+        {
+            auto& [f0] = record;
+            return std::tie(f0);
+        }
+        else if constexpr (N == 2)
+        {
+            auto& [f0, f1] = record;
+            return std::tie(f0, f1);
+        }
+        else if constexpr (N == 3)
+        {
+            auto& [f0, f1, f2] = record;
+            return std::tie(f0, f1, f2);
+        }
+        else if constexpr (N == 4)
+        {
+            auto& [f0, f1, f2, f3] = record;
+            return std::tie(f0, f1, f2, f3);
+        }
+        else if constexpr (N == 5)
+        {
+            auto& [f0, f1, f2, f3, f4] = record;
+            return std::tie(f0, f1, f2, f3, f4);
+        }
+        else if constexpr (N == 6)
+        {
+            auto& [f0, f1, f2, f3, f4, f5] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5);
+        }
+        else if constexpr (N == 7)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6);
+        }
+        else if constexpr (N == 8)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+        }
+        else if constexpr (N == 9)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+        }
+        else if constexpr (N == 10)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+        }
+        else if constexpr (N == 11)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+        }
+        else if constexpr (N == 12)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+        }
+        else if constexpr (N == 13)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+        }
+        else if constexpr (N == 14)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+        }
+        else if constexpr (N == 15)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+        }
+        else if constexpr (N == 16)
+        {
+            auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = record;
+            return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+        }
+    }
+
+    template <typename T>
+    inline constexpr std::size_t field_count_v = field_count<T>();
+
+    template <typename T>
+    constexpr auto fields(T& record)
+    {
+        return tie_fields<field_count_v<std::remove_const_t<T>>>(record);
+    }
+
+    template <typename T, std::size_t I>
+    using field_t = std::remove_cvref_t<std::tuple_element_t<I, decltype(fields(std::declval<T&>()))>>;
+
+    template <typename T, std::size_t... I>
+    constexpr std::size_t count_flags(std::index_sequence<I...> /* unused */)
+    {
+        return (std::size_t{0} + ... + (is_flagged_v<field_t<T, I>> ? 1U : 0U));
+    }
+
+    /// Number of presence bits in front of field I of T.
+    template <typename T, std::size_t I>
+    inline constexpr std::size_t flag_index = count_flags<T>(std::make_index_sequence<I>{});
+
+    template <typename T>
+    inline constexpr std::size_t flag_bytes = (flag_index<T, field_count_v<T>> + 7) / 8;
+
+    template <typename T>
+    inline constexpr bool is_leaf_v = is_scalar_v<T> || is_text_v<T> || is_record_v<T>;
+
+    template <typename T>
+    constexpr bool supported_field()
+    {
+        static_assert(!is_either_v<T>, "either_t does not know its active side; use result_t");
+
+        if constexpr (is_maybe_v<T>)
+        {
+            return is_leaf_v<typename T::value_type>;
+        }
+        else if constexpr (is_result_v<T>)
+        {
+            return (std::is_void_v<typename T::value_type> || is_leaf_v<typename T::value_type>)
+                && is_leaf_v<typename T::error_type>;
+        }
+        else
+        {
+            return is_leaf_v<T>;
+        }
+    }
+
+    template <typename T, std::size_t... I>
+    constexpr bool supported_record(std::index_sequence<I...> /* unused */)
+    {
+        return (supported_field<field_t<T, I>>() && ...);
+    }
+
+    template <typename T>
+    using leaf_view_t = std::conditional_t<is_text_v<T>, std::string_view, std::conditional_t<is_record_v<T>, wire_view_t<T>, T>>;
+
+    template <typename T>
+    std::size_t record_size(const T& record);
+
+    template <typename T>
+    std::byte* write_record(const T& record, std::byte* out);
+
+    template <typename T>
+    std::size_t leaf_size(const T& value)
+    {
+        if constexpr (is_scalar_v<T>)
+        {
+            return sizeof(T);
+        }
+        else if constexpr (is_text_v<T>)
+        {
+            return sizeof(length_type) + value.size();
+        }
+        else
+        {
+            return record_size(value);
+        }
+    }
+
+    template <typename T>
+    std::byte* write_leaf(const T& value, std::byte* out)
+    {
+        if constexpr (is_scalar_v<T>)
+        {
+            std::memcpy(out, &value, sizeof(T));
+            return out + sizeof(T);
+        }
+        else if constexpr (is_text_v<T>)
+        {
+            auto length = static_cast<length_type>(value.size());
+
+            std::memcpy(out, &length, sizeof(length));
+            std::memcpy(out + sizeof(length), value.data(), value.size());
+
+            return out + sizeof(length) + value.size();
+        }
+        else
+        {
+            return write_record(value, out);
+        }
+    }
+
+    /// Number of bytes an encoded T occupies at the front of data, or nothing
+    /// if it runs past the end or does not hold a valid T.
+    template <typename T>
+    maybe_t<std::size_t> measure_leaf(std::span<const std::byte> data)
+    {
+        if constexpr (is_scalar_v<T>)
+        {
+            if (data.size() < sizeof(T))
+            {
+                return utils::nothing;
+            }
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                if (std::to_integer<unsigned>(data[0]) > 1)
+                {
+                    return utils::nothing;
+                }
+            }
+
+            return sizeof(T);
+        }
+        else if constexpr (is_text_v<T>)
+        {
+            length_type length = 0;
+
+            if (data.size() < sizeof(length))
+            {
+                return utils::nothing;
+            }
+
+            std::memcpy(&length, data.data(), sizeof(length));
+
+            if (data.size() - sizeof(length) < length)
+            {
+                return utils::nothing;
+            }
+
+            return sizeof(length) + length;
+        }
+        else
+        {
+            auto view = wire_view_t<T>::parse(data);
+
+            if (!view.has_value())
+            {
+                return utils::nothing;
+            }
+
+            return view->size();
+        }
+    }
+
+    template <typename T>
+    leaf_view_t<T> view_leaf(std::span<const std::byte> data)
+    {
+        if constexpr (is_scalar_v<T>)
+        {
+            T value;
+            std::memcpy(&value, data.data(), sizeof(T));
+
+            return value;
+        }
+        else if constexpr (is_text_v<T>)
+        {
+            length_type length = 0;
+            std::memcpy(&length, data.data(), sizeof(length));
+
+            return {reinterpret_cast<const char*>(data.data() + sizeof(length)), length};  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        }
+        else
+        {
+            return *wire_view_t<T>::parse(data);
+        }
+    }
+
+    template <typename T>
+    T own_leaf(const leaf_view_t<T>& view)
+    {
+        if constexpr (is_record_v<T>)
+        {
+            return view.materialize();
+        }
+        else
+        {
+            return T(view);
+        }
+    }
+
+    inline void set_flag(std::byte* flags, std::size_t index) noexcept
+    {
+        flags[index / 8] |= std::byte{1} << (index % 8);
+    }
+
+    template <typename T, std::size_t I, typename Field>
+    std::size_t field_size(const Field& field)
+    {
+        if constexpr (is_maybe_v<Field>)
+        {
+            return field.has_value() ? leaf_size(*field) : 0;
+        }
+        else if constexpr (is_result_v<Field>)
+        {
+            if (!field.has_value())
+            {
+                return leaf_size(field.error());
+            }
+
+            if constexpr (std::is_void_v<typename Field::value_type>)
+            {
+                return 0;
+            }
+            else
+            {
+                return leaf_size(field.value());
+            }
+        }
+        else
+        {
+            return leaf_size(field);
+        }
+    }
+
+    template <typename T, std::size_t I, typename Field>
+    std::byte* write_field(const Field& field, std::byte* flags, std::byte* out)
+    {
+        if constexpr (is_maybe_v<Field>)
+        {
+            if (!field.has_value())
+            {
+                return out;
+            }
+
+            set_flag(flags, flag_index<T, I>);
+            return write_leaf(*field, out);
+        }
+        else if constexpr (is_result_v<Field>)
+        {
+            if (!field.has_value())
+            {
+                return write_leaf(field.error(), out);
+            }
+
+            set_flag(flags, flag_index<T, I>);
+
+            if constexpr (std::is_void_v<typename Field::value_type>)
+            {
+                return out;
+            }
+            else
+            {
+                return write_leaf(field.value(), out);
+            }
+        }
+        else
+        {
+            return write_leaf(field, out);
+        }
+    }
+
+    template <typename T>
+    std::size_t record_size(const T& record)
+    {
+        static_assert(supported_record<T>(std::make_index_sequence<field_count_v<T>>{}),
+                      "fields have to be arithmetic, enums, strings, records, or maybe_t/result_t of those");
+
+        auto tied = fields(record);
+
+        return [&]<std::size_t... I>(std::index_sequence<I...> /* unused */) {
+            return (flag_bytes<T> + ... + field_size<T, I>(std::get<I>(tied)));
+        }(std::make_index_sequence<field_count_v<T>>{});
+    }
+
+    template <typename T>
+    std::byte* write_record(const T& record, std::byte* out)
+    {
+        auto tied = fields(record);
+        std::byte* flags = out;
+
+        std::memset(flags, 0, flag_bytes<T>);
+        out += flag_bytes<T>;
+
+        [&]<std::size_t... I>(std::index_sequence<I...> /* unused */) {
+            ((out = write_field<T, I>(std::get<I>(tied), flags, out)), ...);
+        }(std::make_index_sequence<field_count_v<T>>{});
+
+        return out;
+    }
+}  // namespace wire
+
+// Number of bytes encode() writes for the record.
+template <typename T>
+    requires(wire::is_record_v<T>)
+std::size_t encoded_size(const T& record)
+{
+    return wire::record_size(record);
+}
+
+// Writes the record into out. The encoding starts with one presence bit per
+// maybe_t or result_t field, set when the maybe_t holds a value or the
+// result_t succeeded, followed by the fields in declaration order with
+// nothing written for an empty maybe_t. Scalars are copied in host byte
+// order, strings are a 32-bit length and the characters, and nested records
+// are encoded the same way inline. Field offsets are 32-bit as well, so
+// records whose encoding is 4 GiB or more fail with too_large.
+template <typename T>
+    requires(wire::is_record_v<T>)
+result_t<std::size_t, wire_error_t> encode(const T& record, std::span<std::byte> out)
+{
+    std::size_t size = wire::record_size(record);
+
+    if (size > std::numeric_limits<wire::length_type>::max())
+    {
+        return fail_t<wire_error_t>(wire_error_t::too_large);
+    }
+
+    if (out.size() < size)
+    {
+        return fail_t<wire_error_t>(wire_error_t::buffer_too_small);
+    }
+
+    wire::write_record(record, out.data());
+
+    return success_t<std::size_t>(size);
+}
+
+/*****************************************************************************/
+/*** CLASSES *****************************************************************/
+
+// A validated encoding of T read in place. parse() checks the bounds and
+// remembers where each field starts, after which get<I>() decodes a single
+// field straight from the buffer: scalars are copied out, strings come back
+// as std::string_view and nested records as views of their own. maybe_t and
+// result_t fields are returned with their payloads viewed the same way.
+// materialize() builds an owning T when one is needed.
+//
+// The buffer has to outlive the view and everything read from it.
+template <typename T>
+class wire_view_t
+{
+    static_assert(wire::is_record_v<T>);
+
+    static constexpr std::size_t field_count = wire::field_count_v<T>;
+    static constexpr std::size_t flag_count = wire::flag_index<T, field_count>;
+
+public:
+    [[nodiscard]] static result_t<wire_view_t, wire_error_t> parse(std::span<const std::byte> buffer)
+    {
+        static_assert(wire::supported_record<T>(std::make_index_sequence<field_count>{}),
+                      "fields have to be arithmetic, enums, strings, records, or maybe_t/result_t of those");
+
+        if (buffer.size() < wire::flag_bytes<T>)
+        {
+            return fail_t<wire_error_t>(wire_error_t::truncated);
+        }
+
+        wire_view_t view(buffer.data());
+
+        if constexpr (flag_count % 8 != 0)
+        {
+            if ((std::to_integer<unsigned>(buffer[wire::flag_bytes<T> - 1]) >> (flag_count % 8)) != 0)
+            {
+                return fail_t<wire_error_t>(wire_error_t::malformed);
+            }
+        }
+
+        std::size_t offset = wire::flag_bytes<T>;
+
+        bool valid = [&]<std::size_t... I>(std::index_sequence<I...> /* unused */) {
+            return (view.template measure<I>(buffer, offset) && ...);
+        }(std::make_index_sequence<field_count>{});
+
+        if (!valid)
+        {
+            return fail_t<wire_error_t>(wire_error_t::truncated);
+        }
+
+        view.m_offsets[field_count] = static_cast<wire::length_type>(offset);
+
+        return success_t<wire_view_t>(view);
+    }
+
+    /// Number of bytes the encoding occupies at the front of the buffer.
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_offsets[field_count];
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] auto get() const
+    {
+        using field_type = wire::field_t<T, I>;
+
+        auto data = std::span<const std::byte>(m_data + m_offsets[I], m_offsets[I + 1] - m_offsets[I]);
+
+        if constexpr (is_maybe_v<field_type>)
+        {
+            using leaf_type = typename field_type::value_type;
+
+            if (!flag(wire::flag_index<T, I>))
+            {
+                return maybe_t<wire::leaf_view_t<leaf_type>>(utils::nothing);
+            }
+
+            return maybe_t<wire::leaf_view_t<leaf_type>>(wire::view_leaf<leaf_type>(data));
+        }
+        else if constexpr (wire::is_result_v<field_type>)
+        {
+            return view_result<field_type>(flag(wire::flag_index<T, I>), data);
+        }
+        else
+        {
+            return wire::view_leaf<field_type>(data);
+        }
+    }
+
+    [[nodiscard]] T materialize() const
+    {
+        return [&]<std::size_t... I>(std::index_sequence<I...> /* unused */) {
+            return T{this->own<I>()...};
+        }(std::make_index_sequence<field_count>{});
+    }
+
+private:
+    explicit wire_view_t(const std::byte* data) noexcept
+        : m_data(data)
+    {}
+
+    [[nodiscard]] bool flag(std::size_t index) const noexcept
+    {
+        return ((std::to_integer<unsigned>(m_data[index / 8]) >> (index % 8)) & 1U) != 0;
+    }
+
+    template <std::size_t I>
+    bool measure(std::span<const std::byte> buffer, std::size_t& offset)
+    {
+        m_offsets[I] = static_cast<wire::length_type>(offset);
+
+        auto length = this->field_length<I>(buffer.subspan(offset));
+
+        if (!length.has_value() || offset + *length > std::numeric_limits<wire::length_type>::max())
+        {
+            return false;
+        }
+
+        offset += *length;
+
+        return true;
+    }
+
+    template <std::size_t I>
+    maybe_t<std::size_t> field_length(std::span<const std::byte> data) const
+    {
+        using field_type = wire::field_t<T, I>;
+
+        if constexpr (is_maybe_v<field_type>)
+        {
+            if (!flag(wire::flag_index<T, I>))
+            {
+                return std::size_t{0};
+            }
+
+            return wire::measure_leaf<typename field_type::value_type>(data);
+        }
+        else if constexpr (wire::is_result_v<field_type>)
+        {
+            if (!flag(wire::flag_index<T, I>))
+            {
+                return wire::measure_leaf<typename field_type::error_type>(data);
+            }
+
+            if constexpr (std::is_void_v<typename field_type::value_type>)
+            {
+                return std::size_t{0};
+            }
+            else
+            {
+                return wire::measure_leaf<typename field_type::value_type>(data);
+            }
+        }
+        else
+        {
+            return wire::measure_leaf<field_type>(data);
+        }
+    }
+
+    template <typename Field>
+    static auto view_result(bool succeeded, std::span<const std::byte> data)
+        -> result_t<std::conditional_t<std::is_void_v<typename Field::value_type>, void, wire::leaf_view_t<typename Field::value_type>>,
+                    wire::leaf_view_t<typename Field::error_type>>
+    {
+        using value_type = typename Field::value_type;
+        using error_type = typename Field::error_type;
+
+        if (!succeeded)
+        {
+            return fail_t<wire::leaf_view_t<error_type>>(wire::view_leaf<error_type>(data));
+        }
+
+        if constexpr (std::is_void_v<value_type>)
+        {
+            return {};
+        }
+        else
+        {
+            return success_t<wire::leaf_view_t<value_type>>(wire::view_leaf<value_type>(data));
+        }
+    }
+
+    template <std::size_t I>
+    wire::field_t<T, I> own() const
+    {
+        using field_type = wire::field_t<T, I>;
+
+        auto field = this->get<I>();
+
+        if constexpr (is_maybe_v<field_type>)
+        {
+            using leaf_type = typename field_type::value_type;
+
+            if (!field.has_value())
+            {
+                return utils::nothing;
+            }
+
+            return wire::own_leaf<leaf_type>(*field);
+        }
+        else if constexpr (wire::is_result_v<field_type>)
+        {
+            using value_type = typename field_type::value_type;
+            using error_type = typename field_type::error_type;
+
+            if (!field.has_value())
+            {
+                return fail_t<error_type>(wire::own_leaf<error_type>(field.error()));
+            }
+
+            if constexpr (std::is_void_v<value_type>)
+            {
+                return {};
+            }
+            else
+            {
+                return success_t<value_type>(wire::own_leaf<value_type>(field.value()));
+            }
+        }
+        else
+        {
+            return wire::own_leaf<field_type>(field);
+        }
+    }
+
+    const std::byte* m_data;
+    std::array<wire::length_type, field_count + 1> m_offsets{};
+};
+
+#endif  // WIRE_HPP
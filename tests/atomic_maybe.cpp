@@ -0,0 +1,195 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "atomic_maybe.hpp"
+
+/// \cond
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+namespace
+{
+
+struct Padded
+{
+    std::uint8_t tag;
+    std::uint16_t value;
+};
+
+struct Snapshot
+{
+    static inline std::atomic<long> alive{0};
+
+    explicit Snapshot(std::uint64_t version)
+    {
+        entries.fill(version);
+        alive.fetch_add(1);
+    }
+
+    Snapshot(const Snapshot& that)
+        : entries(that.entries)
+    {
+        alive.fetch_add(1);
+    }
+
+    Snapshot(Snapshot&& that) noexcept
+        : entries(that.entries)
+    {
+        alive.fetch_add(1);
+    }
+
+    ~Snapshot()
+    {
+        alive.fetch_sub(1);
+    }
+
+    Snapshot& operator=(const Snapshot&) = delete;
+    Snapshot& operator=(Snapshot&&) = delete;
+
+    [[nodiscard]] bool consistent() const
+    {
+        for (auto entry : entries)
+        {
+            if (entry != entries[0])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::array<std::uint64_t, 32> entries{};
+};
+
+}  // namespace
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static_assert(is_packable_v<std::uint32_t>);
+static_assert(is_packable_v<std::array<char, 7>>);
+static_assert(!is_packable_v<std::uint64_t>);
+static_assert(!is_packable_v<std::string>);
+static_assert(!is_packable_v<Padded>);
+static_assert(!is_packable_v<float>);
+
+TEST_CASE("Packed atomic maybe")
+{
+    atomic_maybe_t<std::uint32_t> cell;
+
+    REQUIRE(!cell.has_value());
+    REQUIRE(!cell.load().has_value());
+
+    cell.store(0);
+
+    REQUIRE(cell.has_value());
+    REQUIRE(*cell.load() == 0);
+
+    REQUIRE(cell.compare_exchange(0U, 7U));
+    REQUIRE(!cell.compare_exchange(0U, 9U));
+    REQUIRE(cell.read([](maybe_t<const std::uint32_t&> value) { return value.has_value() ? *value : 0U; }) == 7);
+
+    REQUIRE(cell.compare_exchange(7U, utils::nothing));
+    REQUIRE(!cell.has_value());
+}
+
+TEST_CASE("Published atomic maybe")
+{
+    {
+        atomic_maybe_t<std::string> cell(std::string("first"));
+
+        REQUIRE(*cell.load() == "first");
+
+        cell.emplace(3U, 'x');
+        REQUIRE(cell.read([](maybe_t<const std::string&> value) { return value.has_value() ? *value : std::string(); }) == "xxx");
+
+        cell.reset();
+        REQUIRE(!cell.has_value());
+        REQUIRE(!cell.read([](maybe_t<const std::string&> value) { return value.has_value(); }));
+        REQUIRE(cell.retired() == 0);
+    }
+
+    SECTION("A reader holds back reclamation")
+    {
+        atomic_maybe_t<Snapshot> cell(Snapshot(1));
+
+        cell.read([&](maybe_t<const Snapshot&> held) {
+            cell.store(Snapshot(2));
+
+            REQUIRE(cell.retired() == 1);
+            REQUIRE(held->entries[0] == 1);
+
+            REQUIRE(cell.load()->entries[0] == 2);
+        });
+
+        cell.store(Snapshot(3));
+
+        REQUIRE(cell.retired() == 0);
+    }
+
+    REQUIRE(Snapshot::alive.load() == 0);
+}
+
+TEST_CASE("Readers see whole snapshots under concurrent writes")
+{
+    {
+        atomic_maybe_t<Snapshot> cell(Snapshot(0));
+        std::atomic<bool> done{false};
+        std::atomic<std::size_t> torn{0};
+        std::vector<std::thread> readers;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            readers.emplace_back([&]() {
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    cell.read([&](maybe_t<const Snapshot&> snapshot) {
+                        if (snapshot.has_value() && !snapshot->consistent())
+                        {
+                            torn.fetch_add(1);
+                        }
+                    });
+                }
+            });
+        }
+
+        for (std::uint64_t version = 1; version <= 2000; ++version)
+        {
+            if (version % 100 == 0)
+            {
+                cell.reset();
+            }
+            else
+            {
+                cell.emplace(version);
+            }
+        }
+
+        done.store(true);
+
+        for (auto& reader : readers)
+        {
+            reader.join();
+        }
+
+        REQUIRE(torn.load() == 0);
+
+        cell.store(Snapshot(0));
+        REQUIRE(cell.retired() == 0);
+    }
+
+    REQUIRE(Snapshot::alive.load() == 0);
+}
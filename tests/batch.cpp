@@ -0,0 +1,103 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "batch.hpp"
+
+/// \cond
+#include <cstddef>
+#include <deque>
+#include <ranges>
+#include <string>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+using record_t = result_t<int, std::string>;
+
+static std::deque<record_t> records(std::size_t size, std::size_t every)
+{
+    std::deque<record_t> items;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (every != 0 && i % every == every - 1)
+        {
+            items.emplace_back(fail_t<std::string>("bad " + std::to_string(i)));
+        }
+        else
+        {
+            items.emplace_back(success_t<int>(static_cast<int>(i)));
+        }
+    }
+
+    return items;
+}
+
+TEST_CASE("Collect results")
+{
+    auto good = records(10'000, 0);
+    auto bad = records(10'000, 4'000);
+
+    auto all = collect(good);
+
+    REQUIRE(all.has_value());
+    REQUIRE(all->size() == 10'000);
+    REQUIRE(all->back() == 9'999);
+
+    auto first = collect(bad);
+
+    REQUIRE(!first.has_value());
+    REQUIRE(first.error() == "bad 3999");
+
+    REQUIRE(collect(utils::par, good)->size() == 10'000);
+    REQUIRE(collect(utils::par, bad).error() == "bad 3999");
+}
+
+TEST_CASE("Partition results")
+{
+    auto items = records(10'000, 10);
+
+    auto [values, errors] = partition(items);
+
+    REQUIRE(values.size() == 9'000);
+    REQUIRE(errors.size() == 1'000);
+    REQUIRE(errors.front() == "bad 9");
+
+    auto [par_values, par_errors] = partition(utils::par, std::move(items));
+
+    REQUIRE(par_values == values);
+    REQUIRE(par_errors == errors);
+}
+
+TEST_CASE("Views over lvalue containers are copied from")
+{
+    auto items = records(10'000, 10);
+
+    auto failing = [](const record_t& item) { return !item.has_value(); };
+
+    REQUIRE(collect(std::views::all(items)).error() == "bad 9");
+    REQUIRE(collect(items | std::views::filter(failing)).error() == "bad 9");
+    REQUIRE(partition(utils::par, std::views::all(items)).second.size() == 1'000);
+
+    REQUIRE(items[9].error() == "bad 9");
+    REQUIRE(items.back().error() == "bad 9999");
+}
+
+TEST_CASE("Fold results")
+{
+    auto good = records(10'000, 0);
+    auto bad = records(10'000, 5'000);
+
+    auto plus = [](long acc, int item) { return acc + item; };
+    auto merge = [](long lhs, long rhs) { return lhs + rhs; };
+
+    REQUIRE(*try_fold(good, 0L, plus) == 49'995'000L);
+    REQUIRE(try_fold(bad, 0L, plus).error() == "bad 4999");
+
+    REQUIRE(*try_fold(utils::par, good, 0L, plus, merge) == 49'995'000L);
+    REQUIRE(try_fold(utils::par, bad, 0L, plus, merge).error() == "bad 4999");
+}
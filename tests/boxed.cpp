@@ -0,0 +1,108 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "boxed.hpp"
+
+/// \cond
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+namespace
+{
+
+struct RichError
+{
+    std::string message;
+    std::string context;
+    const char* file;
+    int line;
+    int code;
+};
+
+}  // namespace
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static_assert(sizeof(boxed_t<RichError>) == sizeof(void*));
+static_assert(sizeof(cold_result_t<std::uint64_t, RichError>) == sizeof(result_t<std::uint64_t, int>));
+static_assert(sizeof(cold_result_t<std::uint64_t, RichError>) < sizeof(result_t<std::uint64_t, RichError>));
+static_assert(sizeof(cold_result_t<std::uint32_t, RichError>) == sizeof(result_t<void*, int>));
+
+static cold_result_t<int, RichError> checked_half(int value)
+{
+    if (value % 2 != 0)
+    {
+        return emplace_fail<boxed_t<RichError>>("odd input", "checked_half", __FILE__, __LINE__, value);
+    }
+
+    return success_t<int>(value / 2);
+}
+
+TEST_CASE("Boxed errors keep the result small")
+{
+    auto good = checked_half(8);
+
+    REQUIRE(good.has_value());
+    REQUIRE(*good == 4);
+
+    auto bad = checked_half(7);
+
+    REQUIRE(!bad.has_value());
+    REQUIRE(bad.error()->message == "odd input");
+    REQUIRE(bad.error()->code == 7);
+    REQUIRE((*bad.error()).context == "checked_half");
+}
+
+TEST_CASE("Boxed values are copied deeply and moved by pointer")
+{
+    boxed_t<std::string> original(std::string("payload"));
+    boxed_t<std::string> copy(original);
+
+    REQUIRE(*copy == "payload");
+    REQUIRE(copy.get() != original.get());
+
+    auto* address = original.get();
+    boxed_t<std::string> moved(std::move(original));
+
+    REQUIRE(moved.get() == address);
+    REQUIRE(original.get() == nullptr);  // NOLINT(bugprone-use-after-move, hicpp-invalid-access-moved)
+
+    copy = moved;
+    REQUIRE(*copy == "payload");
+    REQUIRE(copy.get() != moved.get());
+}
+
+TEST_CASE("Boxed slots are reused")
+{
+    const void* first = nullptr;
+
+    {
+        boxed_t<RichError> error(RichError{"first", "", "", 0, 1});
+        first = error.get();
+    }
+
+    boxed_t<RichError> error(RichError{"second", "", "", 0, 2});
+
+    REQUIRE(error.get() == first);
+
+    int code = 0;
+
+    std::thread worker([&code, moved = std::move(error)]() mutable {
+        boxed_t<RichError> local(std::move(moved));
+        code = local->code;
+    });
+
+    worker.join();
+
+    REQUIRE(code == 2);
+}
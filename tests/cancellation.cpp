@@ -0,0 +1,109 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "cancellation.hpp"
+
+#include <unistd.h>
+
+/// \cond
+#include <chrono>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Cancel tokens report why a wait ended")
+{
+    using namespace std::chrono_literals;
+
+    int descriptors[2] = {-1, -1};
+    REQUIRE(::pipe(descriptors) == 0);
+
+    cancel_token_t forever;
+
+    REQUIRE(!forever.cancelled());
+    REQUIRE(!forever.expired());
+
+    auto timed = cancel_token_t::after(5ms).wait(descriptors[0], POLLIN);
+
+    REQUIRE(!timed.has_value());
+    REQUIRE(timed.error() == std::errc::timed_out);
+
+    char byte = 'x';
+    REQUIRE(::write(descriptors[1], &byte, 1) == 1);
+    REQUIRE(forever.wait(descriptors[0], POLLIN).has_value());
+
+    cancel_source_t source;
+    auto token = source.token();
+
+    source.cancel();
+    source.cancel();
+
+    REQUIRE(token.cancelled());
+    REQUIRE(!token.wait(descriptors[0], POLLIN).has_value());
+    REQUIRE(token.wait(descriptors[0], POLLIN).error() == std::errc::operation_canceled);
+
+    ::close(descriptors[0]);
+    ::close(descriptors[1]);
+}
+
+TEST_CASE("Cancelling wakes every waiter")
+{
+    using namespace std::chrono_literals;
+
+    int descriptors[2] = {-1, -1};
+    REQUIRE(::pipe(descriptors) == 0);
+
+    cancel_source_t source;
+    std::vector<std::errc> errors(4);
+
+    {
+        std::vector<std::jthread> waiters;
+
+        for (auto& error : errors)
+        {
+            waiters.emplace_back([&source, &error, reader = descriptors[0]] {
+                auto result = source.token(10s).wait(reader, POLLIN);
+                error = result.has_value() ? std::errc{} : result.error();
+            });
+        }
+
+        std::this_thread::sleep_for(10ms);
+        source.cancel();
+    }
+
+    for (auto error : errors)
+    {
+        REQUIRE(error == std::errc::operation_canceled);
+    }
+
+    ::close(descriptors[0]);
+    ::close(descriptors[1]);
+}
+
+TEST_CASE("Cancel tokens bound sleeps")
+{
+    using namespace std::chrono_literals;
+
+    auto start = std::chrono::steady_clock::now();
+
+    REQUIRE(cancel_token_t().sleep_until(start + 5ms).has_value());
+    REQUIRE(std::chrono::steady_clock::now() - start >= 5ms);
+
+    auto cut = cancel_token_t::after(5ms).sleep_until(start + 10s);
+
+    REQUIRE(!cut.has_value());
+    REQUIRE(cut.error() == std::errc::timed_out);
+
+    cancel_source_t source;
+    source.cancel();
+
+    REQUIRE(source.token().sleep_until(start + 10s).error() == std::errc::operation_canceled);
+    REQUIRE(std::chrono::steady_clock::now() - start < 10s);
+}
@@ -0,0 +1,192 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "channel.hpp"
+#include "socket.hpp"
+
+/// \cond
+#include <sys/wait.h>
+
+#include <unistd.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::size_t bytes(const io_result_t& result)
+{
+    return result.has_value() ? *result : 0;
+}
+
+TEST_CASE("Channel round trip")
+{
+    auto channels = channel_t::pair(64);
+    REQUIRE(channels.has_value());
+
+    auto& [left, right] = *channels;
+    std::array<char, 16> buffer{};
+
+    REQUIRE(bytes(left.send(std::string_view("ping"))) == 4);
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size())) == 4);
+    REQUIRE(std::string_view(buffer.data(), 4) == "ping");
+
+    REQUIRE(bytes(right.send(std::string_view("pong"))) == 4);
+    REQUIRE(bytes(left.recv(buffer.data(), 2)) == 2);
+    REQUIRE(bytes(left.recv(buffer.data() + 2, 2)) == 2);
+    REQUIRE(std::string_view(buffer.data(), 4) == "pong");
+
+    REQUIRE(bytes(left.send(std::string_view("tail"))) == 4);
+    left.close();
+
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size())) == 4);
+
+    auto eof = right.recv(buffer.data(), buffer.size());
+    auto late = right.send(std::string_view("late"));
+
+    REQUIRE(eof.has_value());
+    REQUIRE(*eof == 0);
+    REQUIRE(!late.has_value());
+    REQUIRE(late.error() == std::errc::broken_pipe);
+}
+
+TEST_CASE("Channel delivers what was sent right before closing")
+{
+    for (int round = 0; round < 2000; ++round)
+    {
+        auto channels = channel_t::pair(64);
+        REQUIRE(channels.has_value());
+
+        auto& [left, right] = *channels;
+
+        std::jthread writer([&left = left] {
+            std::ignore = left.send(std::string_view("last"));
+            left.close();
+        });
+
+        std::array<char, 16> buffer{};
+        std::size_t received = 0;
+
+        for (;;)
+        {
+            auto chunk = right.recv(buffer.data() + received, buffer.size() - received);
+
+            REQUIRE(chunk.has_value());
+
+            if (*chunk == 0)
+            {
+                break;
+            }
+
+            received += *chunk;
+        }
+
+        REQUIRE(std::string_view(buffer.data(), received) == "last");
+    }
+}
+
+TEST_CASE("Channel wraps and blocks on a full ring")
+{
+    auto channels = channel_t::pair(64);
+    REQUIRE(channels.has_value());
+
+    auto& [left, right] = *channels;
+
+    std::vector<uint8_t> input(1 << 16);
+
+    for (std::size_t i = 0; i < input.size(); ++i)
+    {
+        input[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    std::jthread producer([&left = left, &input] {
+        std::size_t sent = 0;
+
+        while (sent < input.size())
+        {
+            sent += bytes(left.send(input.data() + sent, std::min<std::size_t>(input.size() - sent, 100)));
+        }
+    });
+
+    std::vector<uint8_t> output(input.size());
+    std::size_t received = 0;
+
+    while (received < output.size())
+    {
+        received += bytes(right.recv(output.data() + received, output.size() - received));
+    }
+
+    REQUIRE(output == input);
+}
+
+TEST_CASE("Channel across processes")
+{
+    auto channels = channel_t::pair(4096);
+    auto control = socket_t::pair(SOCK_SEQPACKET);
+
+    REQUIRE(channels.has_value());
+    REQUIRE(control.has_value());
+
+    pid_t child = ::fork();
+    REQUIRE(child != -1);
+
+    if (child == 0)
+    {
+        int descriptor = -1;
+        auto passed = control->second.recv_descriptors(std::span(&descriptor, 1), nullptr, 0);
+
+        if (!passed || passed->second != 1)
+        {
+            ::_exit(1);
+        }
+
+        auto endpoint = channel_t::attach(descriptor, 1);
+        std::array<char, 8> buffer{};
+
+        bool echoed = endpoint && bytes(endpoint->recv(buffer.data(), 4)) == 4 && bytes(endpoint->send(buffer.data(), 4)) == 4;
+        ::_exit(echoed ? 0 : 1);
+    }
+
+    int descriptor = channels->first.descriptor();
+    REQUIRE(control->first.send_descriptors(std::span(&descriptor, 1), nullptr, 0).has_value());
+
+    std::array<char, 8> buffer{};
+
+    REQUIRE(bytes(channels->first.send(std::string_view("fork"))) == 4);
+    REQUIRE(bytes(channels->first.recv(buffer.data(), buffer.size())) == 4);
+    REQUIRE(std::string_view(buffer.data(), 4) == "fork");
+
+    int status = 0;
+
+    REQUIRE(::waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+}
+
+TEST_CASE("Channel attach rejects a mismatched layout")
+{
+    auto channels = channel_t::pair(4096);
+
+    REQUIRE(channels.has_value());
+
+    int descriptor = channels->first.descriptor();
+    struct stat status
+    {};
+
+    REQUIRE(::fstat(descriptor, &status) == 0);
+    REQUIRE(channel_t::attach(descriptor, 1).has_value());
+
+    REQUIRE(::ftruncate(descriptor, status.st_size + 8192) == 0);
+    REQUIRE(channel_t::attach(descriptor, 1).error() == std::errc::invalid_argument);
+}
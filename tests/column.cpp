@@ -0,0 +1,118 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "column.hpp"
+
+/// \cond
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::vector<maybe_t<std::int64_t>> sparse(std::size_t size)
+{
+    std::vector<maybe_t<std::int64_t>> items;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (i % 3 == 0)
+        {
+            items.emplace_back(utils::nothing);
+        }
+        else
+        {
+            items.emplace_back(static_cast<std::int64_t>(i) - 100);
+        }
+    }
+
+    return items;
+}
+
+TEST_CASE("Column round trip")
+{
+    auto items = sparse(130);
+    column_t<std::int64_t> column(items);
+
+    auto back = column.to_maybe();
+
+    REQUIRE(back.size() == items.size());
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        REQUIRE(back[i].has_value() == items[i].has_value());
+        REQUIRE((!items[i].has_value() || *back[i] == *items[i]));
+    }
+}
+
+TEST_CASE("Column aggregates")
+{
+    auto items = sparse(300'000);
+    column_t<std::int64_t> column(items);
+
+    std::size_t count = 0;
+    std::int64_t sum = 0;
+    std::int64_t min = std::numeric_limits<std::int64_t>::max();
+    std::int64_t max = std::numeric_limits<std::int64_t>::min();
+
+    for (const auto& item : items)
+    {
+        if (item.has_value())
+        {
+            count += 1;
+            sum += *item;
+            min = std::min(min, *item);
+            max = std::max(max, *item);
+        }
+    }
+
+    REQUIRE(column.count() == count);
+    REQUIRE(column.sum() == sum);
+    REQUIRE(*column.min() == min);
+    REQUIRE(*column.max() == max);
+
+    REQUIRE(column.count(utils::par) == count);
+    REQUIRE(column.sum(utils::par) == sum);
+    REQUIRE(*column.min(utils::par) == min);
+    REQUIRE(*column.max(utils::par) == max);
+
+    REQUIRE(column_t<double>(10).sum() == 0.0);
+    REQUIRE(!column_t<double>(10).min().has_value());
+}
+
+TEST_CASE("Column filter and fill")
+{
+    column_t<double> column;
+
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            column.push_back(static_cast<double>(i));
+        }
+        else
+        {
+            column.push_back(utils::nothing);
+        }
+    }
+
+    auto large = column.filter([](double item) { return item >= 100.0; });
+
+    REQUIRE(large.size() == 50);
+    REQUIRE(large.front() == 100.0);
+    REQUIRE(column.filter(utils::par, [](double item) { return item >= 100.0; }) == large);
+
+    column.fill_nothing(-1.0);
+
+    REQUIRE(column.count() == 200);
+    REQUIRE(*column[1] == -1.0);
+    REQUIRE(*column[2] == 2.0);
+    REQUIRE(column.sum() == 9900.0 - 100.0);
+}
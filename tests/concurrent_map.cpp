@@ -0,0 +1,166 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "concurrent_map.hpp"
+
+/// \cond
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Swiss table agrees with std::unordered_map")
+{
+    swiss_table_t<std::uint32_t, std::string> table;
+    std::unordered_map<std::uint32_t, std::string> reference;
+    std::mt19937 random(7);
+
+    for (int i = 0; i < 50000; ++i)
+    {
+        auto key = static_cast<std::uint32_t>(random() % 2048);
+
+        switch (random() % 4)
+        {
+            case 0:
+            case 1:
+            {
+                auto value = std::to_string(i);
+                REQUIRE(table.insert_or_assign(key, value) == reference.insert_or_assign(key, value).second);
+                break;
+            }
+            case 2:
+                REQUIRE(table.erase(key) == (reference.erase(key) == 1));
+                break;
+            default:
+            {
+                auto found = table.find(key);
+                auto expected = reference.find(key);
+
+                REQUIRE(found.has_value() == (expected != reference.end()));
+
+                if (found.has_value())
+                {
+                    REQUIRE(*found == expected->second);
+                }
+            }
+        }
+
+        REQUIRE(table.size() == reference.size());
+    }
+
+    std::size_t visited = 0;
+
+    table.for_each([&](std::uint32_t key, const std::string& value) {
+        REQUIRE(reference.at(key) == value);
+        visited += 1;
+    });
+
+    REQUIRE(visited == reference.size());
+
+    table.clear();
+
+    REQUIRE(table.empty());
+    REQUIRE(!table.find(1).has_value());
+}
+
+TEST_CASE("Swiss table hands out references")
+{
+    swiss_table_t<std::string, std::vector<int>> table;
+
+    auto [values, inserted] = table.try_emplace("primes", 3U, 2);
+
+    REQUIRE(inserted);
+    REQUIRE(values.size() == 3);
+
+    values.push_back(7);
+
+    auto found = table.find("primes");
+
+    REQUIRE(found.has_value());
+    REQUIRE(found->size() == 4);
+
+    REQUIRE(!table.try_emplace("primes").second);
+    REQUIRE(table.contains("primes"));
+    REQUIRE(!table.contains("evens"));
+}
+
+TEST_CASE("Concurrent map from many threads")
+{
+    concurrent_map_t<std::uint64_t, std::uint64_t> map(0, 8);
+    std::vector<std::thread> workers;
+
+    for (std::uint64_t t = 0; t < 4; ++t)
+    {
+        workers.emplace_back([&map, t]() {
+            for (std::uint64_t i = 0; i < 5000; ++i)
+            {
+                std::uint64_t key = t * 100000 + i;
+
+                map.insert_or_assign(key, key * 2);
+
+                if (i % 3 == 0)
+                {
+                    map.erase(key);
+                }
+                else
+                {
+                    map.update(key, [](std::uint64_t& value) { value += 1; });
+                }
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    REQUIRE(map.size() == 4 * (5000 - 1667));
+    REQUIRE(*map.find(100001) == 200003);
+    REQUIRE(!map.find(100003).has_value());
+    REQUIRE(map.bytes() == map.size() * 16);
+}
+
+TEST_CASE("Concurrent map evicts with CLOCK")
+{
+    constexpr std::size_t entry = sizeof(std::uint32_t) + sizeof(std::uint32_t);
+
+    concurrent_map_t<std::uint32_t, std::uint32_t> cache(64 * entry, 1);
+
+    for (std::uint32_t key = 0; key < 64; ++key)
+    {
+        REQUIRE(cache.try_emplace(key, key));
+    }
+
+    REQUIRE(cache.size() == 64);
+
+    for (std::uint32_t key = 0; key < 8; ++key)
+    {
+        REQUIRE(cache.contains(key));
+    }
+
+    for (std::uint32_t key = 64; key < 96; ++key)
+    {
+        cache.insert_or_assign(key, key);
+
+        REQUIRE(cache.bytes() <= 64 * entry);
+        REQUIRE(cache.contains(key));
+    }
+
+    for (std::uint32_t key = 0; key < 8; ++key)
+    {
+        REQUIRE(cache.contains(key));
+    }
+
+    REQUIRE(cache.size() == 64);
+}
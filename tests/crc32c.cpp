@@ -0,0 +1,119 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "crc32c.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::vector<std::byte> random_bytes(std::size_t size)
+{
+    std::mt19937 engine(7);
+    std::vector<std::byte> bytes(size);
+
+    for (auto& byte : bytes)
+    {
+        byte = static_cast<std::byte>(engine());
+    }
+
+    return bytes;
+}
+
+TEST_CASE("CRC-32C matches the published check values")
+{
+    REQUIRE(crc32c_t::compute("") == 0);
+    REQUIRE(crc32c_t::compute("123456789") == 0xE3069283);
+
+    std::array<std::byte, 32> bytes{};
+
+    REQUIRE(crc32c_t::compute(bytes.data(), bytes.size()) == 0x8A9136AA);
+
+    bytes.fill(std::byte{0xFF});
+
+    REQUIRE(crc32c_t::compute(bytes.data(), bytes.size()) == 0x62A8AB43);
+
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+    {
+        bytes[i] = static_cast<std::byte>(i);
+    }
+
+    REQUIRE(crc32c_t::compute(bytes.data(), bytes.size()) == 0x46DD794E);
+}
+
+TEST_CASE("CRC-32C kernels agree at every length and alignment")
+{
+    auto bytes = random_bytes(8 * 1024);
+    const std::array<std::size_t, 6> lengths = {3 * 1024 - 1, 3 * 1024, 3 * 1024 + 200, 6 * 1024 + 7, 8 * 1024 - 3, 191};
+
+    auto check = [&](std::size_t offset, std::size_t length) {
+        std::uint32_t expected = crc32c::portable(0x12345678, bytes.data() + offset, length);
+
+        REQUIRE(crc32c::extend(0x12345678, bytes.data() + offset, length) == expected);
+
+#if CPU_X86_DISPATCH && defined(__x86_64__)
+        if (cpu_t::sse42())
+        {
+            REQUIRE(crc32c::sse42(0x12345678, bytes.data() + offset, length) == expected);
+        }
+
+        if (cpu_t::sse42() && cpu_t::pclmul())
+        {
+            REQUIRE(crc32c::pclmul(0x12345678, bytes.data() + offset, length) == expected);
+        }
+#endif  // CPU_X86_DISPATCH && __x86_64__
+    };
+
+    for (std::size_t offset = 0; offset < 3; ++offset)
+    {
+        for (std::size_t length = 0; length < 600; ++length)
+        {
+            check(offset, length);
+        }
+
+        for (auto length : lengths)
+        {
+            check(offset, length);
+        }
+    }
+}
+
+TEST_CASE("CRC-32C streams across pieces and gathered vectors")
+{
+    auto bytes = random_bytes(5000);
+    std::uint32_t whole = crc32c_t::compute(bytes.data(), bytes.size());
+
+    crc32c_t pieces;
+    pieces.update(bytes.data(), 1).update(bytes.data() + 1, 999).update(std::span<const std::byte>(bytes).subspan(1000));
+
+    REQUIRE(pieces.value() == whole);
+
+    std::array<iovec, 4> vectors = {
+        iovec{bytes.data(), 7},
+        iovec{bytes.data() + 7, 0},
+        iovec{bytes.data() + 7, 3000},
+        iovec{bytes.data() + 3007, 1993},
+    };
+
+    REQUIRE(crc32c_t().update(std::span<const iovec>(vectors)).value() == whole);
+
+    crc32c_t resumed(crc32c_t::compute(bytes.data(), 2500));
+    resumed.update(bytes.data() + 2500, 2500);
+
+    REQUIRE(resumed.value() == whole);
+
+    resumed.reset();
+
+    REQUIRE(resumed.update(std::string_view("123456789")).value() == 0xE3069283);
+}
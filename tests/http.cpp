@@ -0,0 +1,144 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "http.hpp"
+#include "socket.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("HTTP request parsing")
+{
+    std::string_view input = "GET /health?verbose=1 HTTP/1.1\r\n"
+                             "Host: localhost\r\n"
+                             "Accept:  */*  \r\n"
+                             "\r\n";
+
+    http_parser_t parser;
+    auto request = parser.parse(input);
+
+    REQUIRE(request.has_value());
+    REQUIRE(request->method == "GET");
+    REQUIRE(request->target == "/health?verbose=1");
+    REQUIRE(request->minor_version == 1);
+    REQUIRE(request->headers.size() == 2);
+    REQUIRE(request->header("HOST").has_value());
+    REQUIRE(*request->header("HOST") == "localhost");
+    REQUIRE(*request->header("accept") == "*/*");
+    REQUIRE(!request->header("Cookie").has_value());
+    REQUIRE(request->body.empty());
+    REQUIRE(request->size == input.size());
+}
+
+TEST_CASE("HTTP pipelined and incremental requests")
+{
+    std::string input = "POST /submit HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello"
+                        "GET / HTTP/1.0\r\n\r\n";
+
+    http_parser_t parser;
+
+    for (std::size_t size = 0; size < 49; ++size)
+    {
+        auto partial = parser.parse(std::string_view(input).substr(0, size));
+
+        REQUIRE(!partial.has_value());
+        REQUIRE(partial.error() == http_error_t::incomplete);
+    }
+
+    auto first = parser.parse(input);
+
+    REQUIRE(first.has_value());
+    REQUIRE(first->method == "POST");
+    REQUIRE(first->body == "hello");
+    REQUIRE(first->size == 49);
+
+    auto second = parser.parse(std::string_view(input).substr(first->size));
+
+    REQUIRE(second.has_value());
+    REQUIRE(second->method == "GET");
+    REQUIRE(second->minor_version == 0);
+}
+
+TEST_CASE("HTTP request errors")
+{
+    http_parser_t<2> parser(64, 16);
+
+    auto error = [&](std::string_view input) {
+        auto result = parser.parse(input);
+        return result.has_value() ? http_error_t::incomplete : result.error();
+    };
+
+    REQUIRE(error("GET\r\n\r\n") == http_error_t::bad_request);
+    REQUIRE(error("GET /\x01 HTTP/1.1\r\n\r\n") == http_error_t::bad_request);
+    REQUIRE(error("GET / HTTP/2.0\r\n\r\n") == http_error_t::unsupported_version);
+    REQUIRE(error("GET / FTP/1.1\r\n\r\n") == http_error_t::bad_request);
+    REQUIRE(error("GET / HTTP/1.1\r\n folded\r\n\r\n") == http_error_t::bad_request);
+    REQUIRE(error("GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n") == http_error_t::too_many_headers);
+    REQUIRE(error("GET / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n") == http_error_t::unsupported_encoding);
+    REQUIRE(error("GET / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n") == http_error_t::bad_request);
+    REQUIRE(error("GET / HTTP/1.1\r\nContent-Length: 17\r\n\r\n") == http_error_t::body_too_large);
+    REQUIRE(error(std::string(64, 'A')) == http_error_t::head_too_large);
+}
+
+TEST_CASE("HTTP delimiter scanning kernels agree")
+{
+    std::string input(200, 'a');
+
+    for (std::size_t position : {0U, 15U, 16U, 31U, 32U, 100U, 199U})
+    {
+        for (char delimiter : {'\r', '\x01', ' ', '\t', '\x7F'})
+        {
+            auto text = input;
+            text[position] = delimiter;
+
+            auto value = http_scan_t::scalar<true>(text.data(), text.size());
+            auto token = http_scan_t::scalar<false>(text.data(), text.size());
+
+            REQUIRE(http_scan_t::find<true>(text.data(), text.size()) == value);
+            REQUIRE(http_scan_t::find<false>(text.data(), text.size()) == token);
+
+#if CPU_X86_DISPATCH
+            if (cpu_t::sse42())
+            {
+                REQUIRE(http_scan_t::sse42<true>(text.data(), text.size()) == value);
+                REQUIRE(http_scan_t::sse42<false>(text.data(), text.size()) == token);
+            }
+
+            if (cpu_t::avx2())
+            {
+                REQUIRE(http_scan_t::avx2<true>(text.data(), text.size()) == value);
+                REQUIRE(http_scan_t::avx2<false>(text.data(), text.size()) == token);
+            }
+#endif  // CPU_X86_DISPATCH
+        }
+    }
+}
+
+TEST_CASE("HTTP request received over a socket")
+{
+    auto sockets = socket_t::pair();
+    REQUIRE(sockets.has_value());
+
+    REQUIRE(sockets->first.send(std::string_view("GET /ping HTTP/1.1\r\n\r\n")).has_value());
+
+    std::array<char, 256> buffer{};
+    auto received = sockets->second.recv(buffer.data(), buffer.size());
+
+    REQUIRE(received.has_value());
+
+    http_parser_t parser;
+    auto request = parser.parse(std::string_view(buffer.data(), *received));
+
+    REQUIRE(request.has_value());
+    REQUIRE(request->target == "/ping");
+}
@@ -0,0 +1,185 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "inplace_function.hpp"
+
+/// \cond
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+namespace
+{
+
+struct Counted
+{
+    explicit Counted(int& alive)
+        : live(&alive)
+    {
+        ++*live;
+    }
+
+    Counted(Counted&& that) noexcept
+        : live(that.live)
+    {
+        ++*live;
+    }
+
+    Counted(const Counted&) = delete;
+
+    ~Counted()
+    {
+        --*live;
+    }
+
+    Counted& operator=(const Counted&) = delete;
+    Counted& operator=(Counted&&) = delete;
+
+    int operator()(int value) const
+    {
+        return value + *live;
+    }
+
+    int* live;
+};
+
+}  // namespace
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static_assert(sizeof(inplace_function_t<void()>) <= inplace_capacity + 4 * sizeof(void*));
+static_assert(inplace_function_t<void()>::is_inline_v<void (*)()>);
+static_assert(!inplace_function_t<void(), 16>::is_inline_v<std::array<char, 17>>);
+static_assert(!std::is_copy_constructible_v<inplace_function_t<void()>>);
+static_assert(std::is_nothrow_move_constructible_v<inplace_function_t<void()>>);
+
+static int twice(int value)
+{
+    return value * 2;
+}
+
+TEST_CASE("Inplace functions call their target")
+{
+    inplace_function_t<int(int)> empty;
+
+    REQUIRE(!empty);
+    REQUIRE_THROWS_AS(empty(1), std::bad_function_call);
+
+    inplace_function_t<int(int)> pointer(&twice);
+
+    REQUIRE(pointer);
+    REQUIRE(pointer(21) == 42);
+
+    int (*null)(int) = nullptr;
+    inplace_function_t<int(int)> from_null(null);
+
+    REQUIRE(!from_null);
+
+    int total = 0;
+    inplace_function_t<void(int)> accumulate([&total](int value) {
+        total += value;
+    });
+
+    accumulate(3);
+    accumulate(4);
+
+    REQUIRE(total == 7);
+}
+
+TEST_CASE("Inplace functions hold move-only captures")
+{
+    auto owned = std::make_unique<std::string>("payload");
+    inplace_function_t<std::size_t()> length([text = std::move(owned)]() {
+        return text->size();
+    });
+
+    REQUIRE(length() == 7);
+
+    auto moved = std::move(length);
+
+    REQUIRE(!length);  // NOLINT(bugprone-use-after-move, hicpp-invalid-access-moved)
+    REQUIRE(moved() == 7);
+
+    moved = nullptr;
+
+    REQUIRE(!moved);
+}
+
+TEST_CASE("Inplace functions destroy their target exactly once")
+{
+    int alive = 0;
+
+    {
+        inplace_function_t<int(int)> first(std::in_place_type<Counted>, alive);
+
+        REQUIRE(alive == 1);
+        REQUIRE(first(1) == 2);
+
+        inplace_function_t<int(int)> second(std::move(first));
+
+        REQUIRE(alive == 1);
+        REQUIRE(second(1) == 2);
+
+        std::vector<inplace_function_t<int(int)>> queue;
+        queue.push_back(std::move(second));
+        queue.emplace_back(Counted(alive));
+        queue.reserve(64);
+
+        REQUIRE(alive == 2);
+
+        queue.front() = [](int value) {
+            return -value;
+        };
+
+        REQUIRE(alive == 1);
+        REQUIRE(queue.front()(5) == -5);
+    }
+
+    REQUIRE(alive == 0);
+}
+
+TEST_CASE("Unique functions spill large callables to the heap")
+{
+    using small_t = unique_function_t<int(), 16>;
+
+    std::array<int, 32> table{};
+    table[31] = 9;
+
+    auto lookup = [table]() {
+        return table[31];
+    };
+
+    static_assert(!small_t::is_inline_v<decltype(lookup)>);
+
+    small_t large(lookup);
+
+    REQUIRE(large() == 9);
+
+    small_t moved(std::move(large));
+
+    REQUIRE(moved() == 9);
+
+    int alive = 0;
+
+    {
+        unique_function_t<int(int), 8> counted([first = Counted(alive), second = Counted(alive)](int value) {
+            return first(value) + second(value);
+        });
+
+        REQUIRE(alive == 2);
+        REQUIRE(counted(1) == 6);
+    }
+
+    REQUIRE(alive == 0);
+}
@@ -0,0 +1,301 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "journal.hpp"
+#include "loopback.hpp"
+
+#include <unistd.h>
+
+/// \cond
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+namespace
+{
+
+struct scratch_t
+{
+    explicit scratch_t(std::string_view name)
+        : path(std::filesystem::temp_directory_path() / (std::string(name) + '-' + std::to_string(::getpid())))
+    {
+        std::filesystem::remove_all(path);
+    }
+
+    scratch_t(const scratch_t&) = delete;
+    scratch_t(scratch_t&&) = delete;
+
+    ~scratch_t()
+    {
+        std::error_code ignored;
+        std::filesystem::remove_all(path, ignored);
+    }
+
+    scratch_t& operator=(const scratch_t&) = delete;
+    scratch_t& operator=(scratch_t&&) = delete;
+
+    std::filesystem::path path;
+};
+
+std::string_view text(std::span<const std::byte> payload)
+{
+    return {reinterpret_cast<const char*>(payload.data()), payload.size()};  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+}  // namespace
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Journal frames survive concurrent appends across segments")
+{
+    scratch_t scratch("journal-concurrent");
+
+    constexpr std::uint32_t writers = 4;
+    constexpr std::uint32_t frames = 2000;
+
+    {
+        auto journal = journal_t::create(scratch.path, journal_options_t{4096, 16 * 1024});
+
+        REQUIRE(journal.has_value());
+        REQUIRE(journal_t::create(scratch.path).error() == std::errc::operation_would_block);
+
+        std::string oversized(journal->max_frame_length() + 1, 'x');
+
+        REQUIRE(journal->append(0, oversized).error() == std::errc::message_size);
+
+        std::atomic<std::uint32_t> failures{0};
+
+        {
+            std::vector<std::jthread> threads;
+
+            for (std::uint32_t stream = 0; stream < writers; ++stream)
+            {
+                threads.emplace_back([&journal = *journal, &failures, stream] {
+                    for (std::uint32_t i = 0; i < frames; ++i)
+                    {
+                        std::string head = std::to_string(i);
+                        std::string tail(i % 97, static_cast<char>('a' + stream));
+
+                        std::array<iovec, 2> vectors = {iovec{head.data(), head.size()}, iovec{tail.data(), tail.size()}};
+
+                        if (!journal.append(stream, std::span<const iovec>(vectors)))
+                        {
+                            failures.fetch_add(1);
+                        }
+                    }
+                });
+            }
+        }
+
+        REQUIRE(failures.load() == 0);
+    }
+
+    auto reader = journal_reader_t::open(scratch.path);
+
+    REQUIRE(reader.has_value());
+    REQUIRE(reader->size() == writers * frames);
+
+    std::vector<std::uint32_t> next(writers, 0);
+
+    for (std::size_t i = 0; i < reader->size(); ++i)
+    {
+        auto frame = (*reader)[i];
+        auto sequence = next[frame.stream]++;
+        auto head = std::to_string(sequence);
+
+        REQUIRE(frame.intact);
+        REQUIRE(text(frame.payload) == head + std::string(sequence % 97, static_cast<char>('a' + frame.stream)));
+    }
+
+    REQUIRE(reader->lower_bound((*reader)[0].time) == 0);
+    REQUIRE(reader->lower_bound(journal_time_t::max()) == reader->size());
+}
+
+TEST_CASE("Journal readers follow a live journal")
+{
+    scratch_t scratch("journal-live");
+
+    auto journal = journal_t::create(scratch.path, journal_options_t{4096, 0});
+
+    REQUIRE(journal.has_value());
+    REQUIRE(journal->append(1, "first").has_value());
+
+    auto reader = journal_reader_t::open(scratch.path);
+
+    REQUIRE(reader.has_value());
+    REQUIRE(reader->size() == 1);
+    REQUIRE(text((*reader)[0].payload) == "first");
+
+    std::string filler(1000, 'f');
+
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(journal->append(2, filler).has_value());
+    }
+
+    REQUIRE(journal->sync().has_value());
+
+    auto added = reader->refresh();
+
+    REQUIRE(added.has_value());
+    REQUIRE(*added == 10);
+
+    journal->close();
+
+    auto stopped = journal_reader_t::open(scratch.path);
+
+    REQUIRE(stopped.has_value());
+    REQUIRE(stopped->size() == 11);
+    REQUIRE((*stopped)[0].intact);
+
+    {
+        std::FILE* file = std::fopen(journal::segment_path(scratch.path, 0).c_str(), "r+b");
+        REQUIRE(file != nullptr);
+
+        std::fseek(file, static_cast<long>(journal::data_offset + sizeof(journal::frame_header_t)), SEEK_SET);
+        std::fputc('F', file);
+        std::fclose(file);
+    }
+
+    REQUIRE(!(*stopped)[0].intact);
+
+    // A second writer starts its own segment after the first one's, whose
+    // unused tail the reader steps over.
+    auto second = journal_t::create(scratch.path, journal_options_t{4096, 0});
+
+    REQUIRE(second.has_value());
+    REQUIRE(second->append(3, "second").has_value());
+
+    REQUIRE(stopped->refresh().has_value());
+    REQUIRE(stopped->size() == 12);
+    REQUIRE((*stopped)[11].stream == 3);
+    REQUIRE(text((*stopped)[11].payload) == "second");
+
+    // The reader that followed the first writer has mapped its spare
+    // segment, which close() unlinked; the restarted writer must not reuse
+    // that index.
+    auto followed = reader->refresh();
+
+    REQUIRE(followed.has_value());
+    REQUIRE(*followed == 1);
+    REQUIRE(reader->size() == 12);
+    REQUIRE(text((*reader)[11].payload) == "second");
+}
+
+TEST_CASE("Journal readers step over frames their writer abandoned")
+{
+    scratch_t scratch("journal-hole");
+
+    auto journal = journal_t::create(scratch.path, journal_options_t{4096, 0});
+
+    REQUIRE(journal.has_value());
+
+    for (std::string_view message : {"one", "two", "three"})
+    {
+        REQUIRE(journal->append(1, message).has_value());
+    }
+
+    // Turns the second frame back into one whose writer reserved its space
+    // and stopped before committing it.
+    {
+        std::FILE* file = std::fopen(journal::segment_path(scratch.path, 0).c_str(), "r+b");
+        REQUIRE(file != nullptr);
+
+        std::uint32_t word = journal::reserved;
+
+        std::fseek(file, static_cast<long>(journal::data_offset + journal::frame_size(3)), SEEK_SET);
+        std::fwrite(&word, sizeof(word), 1, file);
+        std::fclose(file);
+    }
+
+    auto reader = journal_reader_t::open(scratch.path);
+
+    REQUIRE(reader.has_value());
+    REQUIRE(reader->size() == 1);
+
+    journal->close();
+
+    auto added = reader->refresh();
+
+    REQUIRE(added.has_value());
+    REQUIRE(*added == 1);
+    REQUIRE(text((*reader)[0].payload) == "one");
+    REQUIRE(text((*reader)[1].payload) == "three");
+}
+
+TEST_CASE("Recorded traffic replays through a transport")
+{
+    using namespace std::chrono_literals;
+
+    scratch_t scratch("journal-replay");
+
+    {
+        auto journal = journal_t::create(scratch.path);
+        auto sockets = socket_t::pair();
+
+        REQUIRE(journal.has_value());
+        REQUIRE(sockets.has_value());
+
+        recorder_t recorder(sockets->second, *journal, 7);
+
+        for (std::string_view message : {"GET / HTTP/1.1\r\n\r\n", "GET /a HTTP/1.1\r\n\r\n", "GET /b HTTP/1.1\r\n\r\n"})
+        {
+            REQUIRE(sockets->first.send(message).has_value());
+
+            std::array<char, 64> buffer{};
+            auto received = recorder.recv(buffer.data(), buffer.size());
+
+            REQUIRE(received.has_value());
+            REQUIRE(std::string_view(buffer.data(), *received) == message);
+
+            std::this_thread::sleep_for(20ms);
+        }
+
+        REQUIRE(recorder.dropped() == 0);
+        REQUIRE(journal->append(8, "other stream").has_value());
+    }
+
+    auto reader = journal_reader_t::open(scratch.path);
+
+    REQUIRE(reader.has_value());
+    REQUIRE(reader->size() == 4);
+
+    auto pipe = loopback_t::pair(4096, false);
+
+    REQUIRE(pipe.has_value());
+
+    auto start = std::chrono::steady_clock::now();
+    auto replayed = replay(*reader, pipe->first, replay_options_t{2.0, 7U});
+
+    REQUIRE(replayed.has_value());
+    REQUIRE(*replayed == 3);
+    REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+
+    std::array<char, 128> buffer{};
+    auto received = pipe->second.recv(buffer.data(), buffer.size());
+
+    REQUIRE(received.has_value());
+    REQUIRE(std::string_view(buffer.data(), *received) == "GET / HTTP/1.1\r\n\r\nGET /a HTTP/1.1\r\n\r\nGET /b HTTP/1.1\r\n\r\n");
+
+    cancel_source_t source;
+    source.cancel();
+
+    REQUIRE(replay(*reader, pipe->first, replay_options_t{}, source.token()).error() == std::errc::operation_canceled);
+    REQUIRE(*replay(*reader, pipe->first, replay_options_t{0.0, utils::nothing}) == 4);
+}
@@ -0,0 +1,191 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "loopback.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::size_t bytes(const io_result_t& result)
+{
+    return result.has_value() ? *result : 0;
+}
+
+TEST_CASE("Loopback pipes carry bytes both ways")
+{
+    auto pipe = loopback_t::pair(100, false);
+    REQUIRE(pipe.has_value());
+
+    auto& [left, right] = *pipe;
+    std::array<char, 256> buffer{};
+
+    REQUIRE(left.capacity() == 128);
+    REQUIRE(bytes(left.send(std::string_view("ping"))) == 4);
+    REQUIRE(bytes(right.send(std::string_view("pong!"))) == 5);
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size())) == 4);
+    REQUIRE(std::string_view(buffer.data(), 4) == "ping");
+    REQUIRE(bytes(left.recv(buffer.data(), buffer.size())) == 5);
+    REQUIRE(std::string_view(buffer.data(), 5) == "pong!");
+
+    auto empty = left.recv(buffer.data(), buffer.size());
+
+    REQUIRE(!empty.has_value());
+    REQUIRE(empty.error() == std::errc::operation_would_block);
+
+    std::string first(100, 'a');
+    std::string second(100, 'b');
+    std::array<iovec, 2> vectors{iovec{first.data(), first.size()}, iovec{second.data(), second.size()}};
+
+    REQUIRE(bytes(left.send(vectors)) == 128);
+
+    auto full = left.send(std::string_view("x"));
+
+    REQUIRE(!full.has_value());
+    REQUIRE(full.error() == std::errc::operation_would_block);
+    REQUIRE(bytes(right.recv(buffer.data(), 50)) == 50);
+    REQUIRE(bytes(left.send(vectors)) == 50);
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size())) == 128);
+    REQUIRE(std::string(buffer.data(), 128) == std::string(50, 'a') + std::string(28, 'b') + std::string(50, 'a'));
+}
+
+TEST_CASE("Closing a loopback pipe ends the stream")
+{
+    auto pipe = loopback_t::pair(64, false);
+    REQUIRE(pipe.has_value());
+
+    auto& [left, right] = *pipe;
+    std::array<char, 16> buffer{};
+
+    REQUIRE(bytes(left.send(std::string_view("last"))) == 4);
+
+    left.close();
+
+    REQUIRE(!left.is_open());
+    REQUIRE(!left.send(std::string_view("gone")).has_value());
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size())) == 4);
+
+    auto eof = right.recv(buffer.data(), buffer.size());
+    auto broken = right.send(std::string_view("gone"));
+
+    REQUIRE(eof.has_value());
+    REQUIRE(*eof == 0);
+    REQUIRE(!broken.has_value());
+    REQUIRE(broken.error() == std::errc::broken_pipe);
+}
+
+TEST_CASE("Loopback pipes deliver what was sent right before closing")
+{
+    for (int round = 0; round < 2000; ++round)
+    {
+        auto pipe = loopback_t::pair(64);
+        REQUIRE(pipe.has_value());
+
+        auto& [left, right] = *pipe;
+
+        std::jthread writer([&left = left] {
+            std::ignore = left.send(std::string_view("last"));
+            left.close();
+        });
+
+        std::array<char, 16> buffer{};
+        std::size_t received = 0;
+
+        for (;;)
+        {
+            auto chunk = right.recv(buffer.data() + received, buffer.size() - received);
+
+            REQUIRE(chunk.has_value());
+
+            if (*chunk == 0)
+            {
+                break;
+            }
+
+            received += *chunk;
+        }
+
+        REQUIRE(std::string_view(buffer.data(), received) == "last");
+    }
+}
+
+TEST_CASE("Blocking loopback pipes stream across threads")
+{
+    static constexpr std::size_t total = 1 << 20;
+
+    auto pipe = loopback_t::pair(256);
+    REQUIRE(pipe.has_value());
+
+    auto& [left, right] = *pipe;
+
+    std::jthread producer([&sender = left] {
+        std::vector<std::uint8_t> chunk(1000);
+        std::size_t sent = 0;
+
+        while (sent < total)
+        {
+            std::size_t length = std::min(chunk.size(), total - sent);
+
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                chunk[i] = static_cast<std::uint8_t>((sent + i) * 7);
+            }
+
+            std::size_t offset = 0;
+
+            while (offset < length)
+            {
+                auto result = sender.send(chunk.data() + offset, length - offset);
+
+                if (!result)
+                {
+                    return;
+                }
+
+                offset += *result;
+            }
+
+            sent += length;
+        }
+
+        sender.close();
+    });
+
+    std::vector<std::uint8_t> buffer(333);
+    std::size_t received = 0;
+    std::size_t mismatches = 0;
+
+    for (;;)
+    {
+        auto result = right.recv(buffer.data(), buffer.size());
+
+        if (!result || *result == 0)
+        {
+            break;
+        }
+
+        for (std::size_t i = 0; i < *result; ++i)
+        {
+            mismatches += buffer[i] != static_cast<std::uint8_t>((received + i) * 7) ? 1U : 0U;
+        }
+
+        received += *result;
+    }
+
+    REQUIRE(received == total);
+    REQUIRE(mismatches == 0);
+}
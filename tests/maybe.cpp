@@ -8,6 +8,7 @@
 /// \cond
 #include <cstddef>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 /// \endcond
@@ -15,6 +16,9 @@
 /*****************************************************************************/
 /*** DATA TYPES **************************************************************/
 
+namespace
+{
+
 struct Counters
 {
     std::size_t constructor_call;
@@ -89,6 +93,8 @@ struct Widget
     }
 };
 
+}  // namespace
+
 /*****************************************************************************/
 /*** TEST CASES **************************************************************/
 
@@ -193,3 +199,51 @@ TEST_CASE("Swap Me Maybe")
 
     REQUIRE(counters.swap_call == 1);
 }
+
+TEST_CASE("Refer Me Maybe")
+{
+    static_assert(sizeof(maybe_t<Widget&>) == sizeof(Widget*));
+    static_assert(std::is_trivially_copyable_v<maybe_t<Widget&>>);
+
+    Counters counters{};
+
+    {
+        Widget widget{std::addressof(counters)};
+
+        maybe_t<Widget&> found = widget;
+        maybe_t<Widget&> missing = utils::nothing;
+        maybe_t<const Widget&> view = found;
+
+        REQUIRE(found.has_value());
+        REQUIRE(!missing.has_value());
+        REQUIRE(std::addressof(*view) == std::addressof(widget));
+
+        auto copy = found;
+        missing = copy;
+        copy = utils::nothing;
+
+        REQUIRE(!copy.has_value());
+        REQUIRE(missing->m_counters == std::addressof(counters));
+
+        std::size_t calls = 0;
+
+        found.and_then([&](Widget& /* unused */) { calls += 1; })
+            .or_else([&]() { calls += 10; });
+
+        copy.and_then([&](Widget& /* unused */) { calls += 1; })
+            .or_else([&]() { calls += 10; });
+
+        auto counter = found.now([](Widget& item) { return maybe_t<Counters*>(item.m_counters); });
+
+        REQUIRE(calls == 11);
+        REQUIRE(*counter == std::addressof(counters));
+        REQUIRE(copy.or_else([&]() { return found; }).has_value());
+    }
+
+    REQUIRE(counters.constructor_call == 1);
+
+    REQUIRE(counters.copy_constructor_call == 0);
+    REQUIRE(counters.move_constructor_call == 0);
+
+    REQUIRE(counters.destructor_call == 1);
+}
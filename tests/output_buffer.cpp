@@ -0,0 +1,153 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "loopback.hpp"
+#include "output_buffer.hpp"
+
+/// \cond
+#include <fcntl.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+template <transport Transport>
+static std::string drain(const Transport& socket)
+{
+    std::string result;
+    std::vector<char> buffer(1 << 16);
+
+    for (;;)
+    {
+        auto received = socket.recv(buffer.data(), buffer.size());
+
+        if (!received || *received == 0)
+        {
+            return result;
+        }
+
+        result.append(buffer.data(), *received);
+    }
+}
+
+TEST_CASE("Output buffer coalesces writes")
+{
+    auto sockets = socket_t::pair();
+    REQUIRE(sockets.has_value());
+
+    auto& [left, right] = *sockets;
+    ::fcntl(right.descriptor(), F_SETFL, O_NONBLOCK);
+
+    std::string body(100, 'x');
+    output_buffer_t output;
+
+    output.append(std::string_view("HTTP/1.1 200 OK\r\n"));
+    output.append(std::string_view("Content-Length: 100\r\n\r\n"));
+    output.append_reference(body.data(), body.size());
+    output.append(std::string_view("\r\n"));
+
+    REQUIRE(output.pending() == 17 + 23 + 100 + 2);
+
+    auto flushed = output.flush(left);
+
+    REQUIRE(flushed.has_value());
+    REQUIRE(*flushed == 142);
+    REQUIRE(output.empty());
+    REQUIRE(drain(right) == "HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\n" + body + "\r\n");
+}
+
+TEST_CASE("Output buffer keeps the unsent tail and applies watermarks")
+{
+    auto sockets = socket_t::pair();
+    REQUIRE(sockets.has_value());
+
+    auto& [left, right] = *sockets;
+
+    ::fcntl(left.descriptor(), F_SETFL, O_NONBLOCK);
+    ::fcntl(right.descriptor(), F_SETFL, O_NONBLOCK);
+
+    int size = 4096;
+    ::setsockopt(left.descriptor(), SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+
+    output_buffer_t output(1024, 64 * 1024);
+    std::string expected;
+
+    for (int i = 0; output.accepting(); ++i)
+    {
+        auto line = "line " + std::to_string(i) + "\n";
+
+        output.append(line);
+        expected += line;
+    }
+
+    REQUIRE(output.pending() >= 64 * 1024);
+
+    std::string actual;
+
+    while (!output.empty())
+    {
+        auto flushed = output.flush(left);
+
+        if (!flushed)
+        {
+            REQUIRE(flushed.error() == std::errc::operation_would_block);
+        }
+
+        if (!output.empty())
+        {
+            REQUIRE(!output.accepting());
+        }
+
+        actual += drain(right);
+    }
+
+    actual += drain(right);
+
+    REQUIRE(output.accepting());
+    REQUIRE(actual == expected);
+}
+
+TEST_CASE("Output buffer flushes into any gather transport")
+{
+    auto pipe = loopback_t::pair(64, false);
+    REQUIRE(pipe.has_value());
+
+    auto& [left, right] = *pipe;
+
+    output_buffer_t output(16, 128);
+    std::string header(40, 'h');
+    std::string body(100, 'b');
+
+    output.append(header);
+    output.append_reference(body.data(), body.size());
+
+    auto first = output.flush(left);
+
+    REQUIRE(first.has_value());
+    REQUIRE(*first == 64);
+    REQUIRE(output.pending() == 76);
+
+    auto full = output.flush(left);
+
+    REQUIRE(!full.has_value());
+    REQUIRE(full.error() == std::errc::operation_would_block);
+
+    std::string actual = drain(right);
+
+    while (!output.empty())
+    {
+        REQUIRE(output.flush(left).has_value());
+        actual += drain(right);
+    }
+
+    REQUIRE(actual == header + body);
+}
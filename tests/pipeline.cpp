@@ -0,0 +1,133 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "pipeline.hpp"
+
+/// \cond
+#include <cstddef>
+#include <string>
+#include <utility>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+namespace
+{
+
+struct Tracked
+{
+    static inline std::size_t moves = 0;
+    static inline std::size_t destructions = 0;
+
+    explicit Tracked(std::string text)
+        : value(std::move(text))
+    {}
+
+    Tracked(const Tracked& that) = default;
+
+    Tracked(Tracked&& that) noexcept
+        : value(std::move(that.value))
+    {
+        moves += 1;
+    }
+
+    ~Tracked()
+    {
+        destructions += 1;
+    }
+
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+
+    std::string value;
+};
+
+}  // namespace
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static maybe_t<Tracked> parse(const std::string& text)
+{
+    if (text.empty())
+    {
+        return utils::nothing;
+    }
+
+    return maybe_t<Tracked>(text);
+}
+
+TEST_CASE("Pipeline evaluation")
+{
+    maybe_t<std::string> input = std::string("42");
+    maybe_t<std::string> empty = utils::nothing;
+
+    auto length = [](Tracked&& item) { return maybe_t<std::size_t>(item.value.size()); };
+    auto fallback = []() { return maybe_t<std::size_t>(std::size_t{0}); };
+
+    maybe_t<std::size_t> present = input | and_then(parse) | and_then(length) | or_else(fallback);
+    maybe_t<std::size_t> missing = empty | and_then(parse) | and_then(length) | or_else(fallback);
+    maybe_t<std::size_t> nothing = empty | and_then(parse) | and_then(length);
+
+    REQUIRE(*present == 2);
+    REQUIRE(*missing == 0);
+    REQUIRE(!nothing.has_value());
+
+    std::size_t calls = 0;
+
+    auto touched = (input | and_then([&](std::string& /* unused */) { calls += 1; }) | or_else([&]() { calls += 10; })).evaluate();
+    auto skipped = (empty | and_then([&](std::string& /* unused */) { calls += 1; }) | or_else([&]() { calls += 10; })).evaluate();
+
+    REQUIRE(calls == 11);
+    REQUIRE(*touched == "42");
+    REQUIRE(!skipped.has_value());
+}
+
+TEST_CASE("Pipeline materializes only the final result")
+{
+    maybe_t<std::string> input = std::string("payload");
+
+    auto forward = [](Tracked&& item) { return maybe_t<Tracked>(std::move(item)); };
+
+    Tracked::moves = 0;
+    Tracked::destructions = 0;
+
+    {
+        maybe_t<Tracked> result = input | and_then(parse) | and_then(forward) | and_then(forward);
+        REQUIRE(result->value == "payload");
+    }
+
+    auto fused_moves = Tracked::moves;
+    auto fused_destructions = Tracked::destructions;
+
+    Tracked::moves = 0;
+    Tracked::destructions = 0;
+
+    {
+        maybe_t<Tracked> result = utils::nothing;
+
+        if (input.has_value())
+        {
+            auto first = parse(*input);
+
+            if (first.has_value())
+            {
+                auto second = forward(std::move(*first));
+
+                if (second.has_value())
+                {
+                    result = forward(std::move(*second));
+                }
+            }
+        }
+
+        REQUIRE(result->value == "payload");
+    }
+
+    REQUIRE(fused_moves <= Tracked::moves);
+    REQUIRE(fused_destructions <= Tracked::destructions);
+}
@@ -0,0 +1,127 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "rate_limiter.hpp"
+
+/// \cond
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+TEST_CASE("Cheap clocks follow steady_clock")
+{
+    using namespace std::chrono_literals;
+
+    auto steady_start = std::chrono::steady_clock::now();
+    auto tsc_start = tsc_clock_t::now();
+    auto coarse_start = coarse_clock_t::now();
+
+    std::this_thread::sleep_for(20ms);
+
+    auto steady = std::chrono::steady_clock::now() - steady_start;
+    auto tsc = tsc_clock_t::now() - tsc_start;
+    auto coarse = coarse_clock_t::now() - coarse_start;
+
+    REQUIRE(tsc > steady * 9 / 10);
+    REQUIRE(tsc < steady * 11 / 10);
+    REQUIRE(coarse > steady - coarse_clock_t::resolution() * 2);
+    REQUIRE(coarse < steady + coarse_clock_t::resolution() * 2);
+    REQUIRE(coarse_clock_t::resolution() > 0ns);
+}
+
+TEST_CASE("Token buckets allow a burst and then the rate")
+{
+    using namespace std::chrono_literals;
+
+    token_bucket_t<> bucket(1000.0, 10);
+
+    REQUIRE(bucket.available() == 10);
+    REQUIRE(bucket.try_acquire(4));
+    REQUIRE(bucket.acquire_up_to(100) == 6);
+    REQUIRE(!bucket.try_acquire());
+    REQUIRE(bucket.acquire_up_to(100) == 0);
+    REQUIRE(bucket.wait_time(5) > 3ms);
+    REQUIRE(bucket.wait_time(5) <= 5ms);
+
+    bucket.release(3);
+
+    REQUIRE(bucket.try_acquire(3));
+    REQUIRE(!bucket.try_acquire(11));
+
+    std::this_thread::sleep_for(bucket.wait_time(2));
+
+    REQUIRE(bucket.try_acquire(2));
+}
+
+TEST_CASE("Token buckets hold the rate under contention")
+{
+    using namespace std::chrono_literals;
+
+    static constexpr double rate = 20000.0;
+    static constexpr std::size_t burst = 100;
+
+    token_bucket_t<> bucket(rate, burst);
+    std::atomic<std::size_t> granted{0};
+    std::atomic<bool> stop{false};
+    std::vector<std::jthread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < 4; ++i)
+    {
+        workers.emplace_back([&bucket, &granted, &stop, i] {
+            token_cache_t<> cache(bucket, 8);
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                bool taken = i % 2 == 0 ? bucket.try_acquire() : cache.try_acquire();
+                granted.fetch_add(taken ? 1 : 0, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(50ms);
+    stop.store(true);
+    workers.clear();
+
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    auto ceiling = static_cast<double>(burst + 2 * 8) + rate * seconds * 1.05;
+
+    REQUIRE(static_cast<double>(granted.load()) <= ceiling);
+    REQUIRE(granted.load() >= burst);
+}
+
+TEST_CASE("Leaky buckets space work evenly and bound the queue")
+{
+    using namespace std::chrono_literals;
+
+    leaky_bucket_t<> bucket(1000.0, 5);
+
+    auto first = bucket.schedule();
+    auto second = bucket.schedule();
+    auto batch = bucket.schedule(3);
+
+    REQUIRE(first.has_value());
+    REQUIRE(second.has_value());
+    REQUIRE(batch.has_value());
+    REQUIRE(*first == 0ns);
+    REQUIRE(*second > 900us);
+    REQUIRE(*second <= 1ms);
+    REQUIRE(*batch > 1900us);
+    REQUIRE(bucket.queued() <= 5);
+
+    REQUIRE(!bucket.schedule().has_value());
+
+    std::this_thread::sleep_for(2ms);
+
+    REQUIRE(bucket.schedule().has_value());
+}
@@ -0,0 +1,212 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "result.hpp"
+
+/// \cond
+#include <array>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+namespace
+{
+
+struct Tracked
+{
+    static inline std::size_t copies = 0;
+    static inline std::size_t moves = 0;
+
+    explicit Tracked(int first, std::string second)
+        : number(first)
+        , text(std::move(second))
+    {}
+
+    Tracked(const Tracked& that)
+        : number(that.number)
+        , text(that.text)
+    {
+        copies += 1;
+    }
+
+    Tracked(Tracked&& that) noexcept
+        : number(that.number)
+        , text(std::move(that.text))
+    {
+        moves += 1;
+    }
+
+    ~Tracked() = default;
+
+    Tracked& operator=(const Tracked&) = delete;
+    Tracked& operator=(Tracked&&) = delete;
+
+    int number;
+    std::string text;
+};
+
+}  // namespace
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static constexpr result_t<int, std::errc> parse_digit(char digit)
+{
+    if (digit < '0' || digit > '9')
+    {
+        return fail_t<std::errc>(std::errc::invalid_argument);
+    }
+
+    return success_t<int>(digit - '0');
+}
+
+static constexpr result_t<void, std::errc> check_even(int number)
+{
+    if (number % 2 != 0)
+    {
+        return fail_t<std::errc>(std::errc::result_out_of_range);
+    }
+
+    return {};
+}
+
+static constexpr std::size_t either_switch()
+{
+    either_t<int, std::string> storage(either_t<int, std::string>::left, 4);
+
+    storage.get(either_t<int, std::string>::left) += 1;
+    storage.destruct(either_t<int, std::string>::left);
+    storage.construct(either_t<int, std::string>::right, "switched");
+
+    std::size_t length = storage.get(either_t<int, std::string>::right).size();
+    storage.destruct(either_t<int, std::string>::right);
+
+    return length;
+}
+
+static constexpr result_t<std::vector<int>, std::vector<int>> make_owning(bool succeed)
+{
+    if (!succeed)
+    {
+        return fail_t<std::vector<int>>(8U, 0);
+    }
+
+    return success_t<std::vector<int>>(5U, 1);
+}
+
+static constexpr std::size_t owning_result(bool succeed)
+{
+    auto result = make_owning(succeed);
+
+    return result ? result.value().size() : result.error().size();
+}
+
+// Built entirely at compile time; nothing runs at startup.
+static constexpr std::array<result_t<int, std::errc>, 3> digit_table = {
+    parse_digit('1'),
+    parse_digit('x'),
+    parse_digit('9'),
+};
+
+static_assert(parse_digit('7').value() == 7);
+static_assert(!parse_digit('x'));
+static_assert(parse_digit('x').error() == std::errc::invalid_argument);
+static_assert(check_even(4).has_value());
+static_assert(!check_even(3));
+static_assert(either_switch() == 8);
+static_assert(owning_result(true) == 5);
+static_assert(owning_result(false) == 8);
+static_assert(digit_table[0].value() == 1);
+static_assert(!digit_table[1].has_value());
+static_assert(*digit_table[2] == 9);
+static_assert(result_t<int, std::errc>(emplace_success<int>(3)).value() == 3);
+static_assert(result_t<int, std::errc>(std::in_place_type<fail_t<std::errc>>, std::errc::io_error).error() == std::errc::io_error);
+
+TEST_CASE("Compile-time results are usable at run time")
+{
+    REQUIRE(digit_table[0].value() == 1);
+    REQUIRE(digit_table[1].error() == std::errc::invalid_argument);
+    REQUIRE(owning_result(false) == 8);
+}
+
+static result_t<Tracked, std::string> wrapped(int number)
+{
+    return success_t<Tracked>(Tracked(number, "wrapped"));
+}
+
+static result_t<Tracked, std::string> in_place(int number)
+{
+    return result_t<Tracked, std::string>(std::in_place_type<success_t<Tracked>>, number, "in place");
+}
+
+static result_t<Tracked, std::string> emplaced(int number, const std::string& text)
+{
+    if (number < 0)
+    {
+        return emplace_fail<std::string>(text.size(), '-');
+    }
+
+    return emplace_success<Tracked>(number, text);
+}
+
+TEST_CASE("Results are constructed in place")
+{
+    Tracked::copies = 0;
+    Tracked::moves = 0;
+
+    SECTION("Through success_t")
+    {
+        auto result = wrapped(1);
+
+        REQUIRE(result->text == "wrapped");
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 2);
+    }
+
+    SECTION("Through std::in_place_type")
+    {
+        auto result = in_place(2);
+
+        REQUIRE(result->number == 2);
+        REQUIRE(result->text == "in place");
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+    }
+
+    SECTION("Through emplace helpers")
+    {
+        std::string text = "emplaced";
+
+        auto success = emplaced(3, text);
+        auto failure = emplaced(-1, text);
+
+        REQUIRE(success->number == 3);
+        REQUIRE(success->text == "emplaced");
+        REQUIRE(text == "emplaced");
+        REQUIRE(failure.error() == "--------");
+        REQUIRE(Tracked::copies == 0);
+        REQUIRE(Tracked::moves == 0);
+    }
+
+    SECTION("Wrappers forward their arguments")
+    {
+        std::string text = "forwarded";
+        success_t<std::string> copied(text);
+        success_t<std::string> moved(std::move(text));
+
+        REQUIRE(*copied == "forwarded");
+        REQUIRE(*moved == "forwarded");
+
+        result_t<void, std::string> failure = emplace_fail<std::string>(3U, 'x');
+
+        REQUIRE(failure.error() == "xxx");
+    }
+}
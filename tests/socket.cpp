@@ -0,0 +1,459 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "socket.hpp"
+
+/// \cond
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static std::size_t bytes(const io_result_t& result)
+{
+    return result.has_value() ? *result : 0;
+}
+
+TEST_CASE("Socket pair round trip")
+{
+    for (int type : {SOCK_STREAM, SOCK_SEQPACKET})
+    {
+        auto sockets = socket_t::pair(type);
+        REQUIRE(sockets.has_value());
+
+        auto& [left, right] = *sockets;
+        std::array<char, 16> buffer{};
+
+        REQUIRE(bytes(left.send(std::string_view("ping"))) == 4);
+        REQUIRE(bytes(right.recv(buffer.data(), buffer.size())) == 4);
+        REQUIRE(std::string_view(buffer.data(), 4) == "ping");
+    }
+}
+
+TEST_CASE("Socket descriptor passing")
+{
+    auto control = socket_t::pair(SOCK_SEQPACKET);
+    auto payload = socket_t::pair();
+
+    REQUIRE(control.has_value());
+    REQUIRE(payload.has_value());
+
+    REQUIRE(control->first.send_socket(payload->second).has_value());
+    payload->second.close();
+
+    auto received = control->second.recv_socket();
+    REQUIRE(received.has_value());
+
+    std::array<char, 16> buffer{};
+
+    REQUIRE(bytes(payload->first.send(std::string_view("handoff"))) == 7);
+    REQUIRE(bytes(received->recv(buffer.data(), buffer.size())) == 7);
+    REQUIRE(std::string_view(buffer.data(), 7) == "handoff");
+
+    std::array<int, 2> descriptors{control->first.descriptor(), payload->first.descriptor()};
+    std::array<int, 2> duplicates{-1, -1};
+
+    REQUIRE(bytes(control->first.send_descriptors(descriptors, "tag", 3)) == 3);
+
+    auto result = control->second.recv_descriptors(duplicates, buffer.data(), buffer.size());
+
+    REQUIRE(result.has_value());
+    REQUIRE(result->first == 3);
+    REQUIRE(result->second == 2);
+    REQUIRE(duplicates[0] != -1);
+    REQUIRE(duplicates[1] != -1);
+
+    ::close(duplicates[0]);
+    ::close(duplicates[1]);
+}
+
+TEST_CASE("Endpoint parsing")
+{
+    auto ipv4 = endpoint_t::parse("127.0.0.1", 8080);
+    auto ipv6 = endpoint_t::parse(std::string_view("::1 trailing").substr(0, 3), 443);
+
+    REQUIRE(ipv4.has_value());
+    REQUIRE(ipv4->family() == AF_INET);
+    REQUIRE(ipv4->port() == 8080);
+    REQUIRE(ipv4->size() == sizeof(sockaddr_in));
+
+    REQUIRE(ipv6.has_value());
+    REQUIRE(ipv6->family() == AF_INET6);
+    REQUIRE(ipv6->port() == 443);
+
+    REQUIRE(!endpoint_t::parse("256.0.0.1", 1).has_value());
+    REQUIRE(!endpoint_t::parse("not an address", 1).has_value());
+
+    auto mapped = ipv4->mapped();
+
+    REQUIRE(mapped.family() == AF_INET6);
+    REQUIRE(mapped.port() == 8080);
+
+    auto local = endpoint_t::local("/tmp/utils.sock");
+
+    REQUIRE(local.has_value());
+    REQUIRE(local->family() == AF_UNIX);
+
+    std::string oversized(sizeof(sockaddr_un::sun_path), 'p');
+
+    REQUIRE(!endpoint_t::local(oversized).has_value());
+    REQUIRE(socket_t(AF_UNIX, SOCK_STREAM).bind_local(oversized).error() == std::errc::filename_too_long);
+
+    // An abstract name is matched byte for byte, so a peer using the raw
+    // sockaddr with the exact length has to reach it.
+    std::string abstract = std::string(1, '\0') + "utils-" + std::to_string(::getpid());
+
+    REQUIRE(endpoint_t::local(abstract)->size() == offsetof(sockaddr_un, sun_path) + abstract.size());
+
+    socket_t listener(AF_UNIX, SOCK_STREAM);
+
+    REQUIRE(listener.bind_local(abstract).has_value());
+    REQUIRE(listener.listen().has_value());
+
+    sockaddr_un exact{};
+    exact.sun_family = AF_UNIX;
+    std::memcpy(exact.sun_path, abstract.data(), abstract.size());
+
+    socket_t raw(AF_UNIX, SOCK_STREAM);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    REQUIRE(::connect(raw.descriptor(), reinterpret_cast<const sockaddr*>(&exact), static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + abstract.size())) == 0);
+    REQUIRE(socket_t(AF_UNIX, SOCK_STREAM).connect_local(abstract).has_value());
+}
+
+TEST_CASE("Dual-stack socket accepts IPv4 and IPv6 peers")
+{
+    auto address = endpoint_t::any(0);
+
+    socket_t server(address);
+
+    REQUIRE(server.bind(address).has_value());
+    REQUIRE(server.listen().has_value());
+
+    auto bound = server.local_endpoint();
+
+    REQUIRE(bound.has_value());
+    REQUIRE(bound->family() == AF_INET6);
+    REQUIRE(bound->port() != 0);
+
+    for (auto peer : {endpoint_t::ipv4(INADDR_LOOPBACK, bound->port()), *endpoint_t::parse("::1", bound->port())})
+    {
+        socket_t client(peer);
+        REQUIRE(client.connect(peer).has_value());
+
+        auto accepted = server.accept();
+        REQUIRE(accepted.has_value());
+        std::array<char, 8> buffer{};
+
+        REQUIRE(bytes(client.send(std::string_view("dual"))) == 4);
+        REQUIRE(bytes(accepted->recv(buffer.data(), buffer.size())) == 4);
+    }
+}
+
+TEST_CASE("Socket errors are reported")
+{
+    auto sockets = socket_t::pair();
+    REQUIRE(sockets.has_value());
+
+    auto& [left, right] = *sockets;
+    std::array<char, 8> buffer{};
+
+    ::fcntl(right.descriptor(), F_SETFL, O_NONBLOCK);
+
+    auto empty = right.recv(buffer.data(), buffer.size());
+
+    REQUIRE(!empty.has_value());
+    REQUIRE(empty.error() == std::errc::operation_would_block);
+
+    left.close();
+
+    auto eof = right.recv(buffer.data(), buffer.size());
+
+    REQUIRE(eof.has_value());
+    REQUIRE(*eof == 0);
+
+    auto broken = right.send(std::string_view("gone"));
+
+    REQUIRE(!broken.has_value());
+    REQUIRE(broken.error() == std::errc::broken_pipe);
+
+    socket_t client;
+
+    auto invalid = client.connect("not an address", 1);
+    auto refused = client.connect("127.0.0.1", 1);
+
+    REQUIRE(!invalid.has_value());
+    REQUIRE(invalid.error() == std::errc::invalid_argument);
+    REQUIRE(!refused.has_value());
+    REQUIRE(refused.error() == std::errc::connection_refused);
+}
+
+TEST_CASE("Kernel timestamps and TCP statistics")
+{
+    auto address = endpoint_t::ipv4(INADDR_LOOPBACK, 0);
+
+    socket_t server(address);
+
+    REQUIRE(server.bind(address).has_value());
+    REQUIRE(server.listen().has_value());
+
+    auto bound = server.local_endpoint();
+
+    REQUIRE(bound.has_value());
+
+    address = *bound;
+
+    socket_t client(address);
+    REQUIRE(client.connect(address).has_value());
+
+    auto accepted = server.accept();
+    REQUIRE(accepted.has_value());
+
+    REQUIRE(client.enable_timestamps().has_value());
+    REQUIRE(accepted->enable_timestamps(false).has_value());
+
+    // The kernel flips its receive timestamping switch from a work item, so
+    // the first packets after enabling it may arrive unstamped.
+    std::array<char, 16> buffer{};
+    std::size_t sent = 0;
+    maybe_t<kernel_time_t> stamped = utils::nothing;
+
+    while (!stamped.has_value() && sent < 1000)
+    {
+        REQUIRE(bytes(client.send(std::string_view("stamped"))) == 7);
+        sent += 1;
+
+        auto received = accepted->recv_timestamped(buffer.data(), buffer.size());
+
+        REQUIRE(received.has_value());
+        REQUIRE(received->bytes == 7);
+
+        stamped = received->kernel_time;
+    }
+
+    REQUIRE(stamped.has_value());
+
+    auto transmitted = client.recv_tx_timestamp();
+
+    REQUIRE(transmitted.has_value());
+    REQUIRE(transmitted->id == 6);
+    REQUIRE(transmitted->kernel_time <= *stamped);
+
+    auto sender = client.stats();
+    auto receiver = accepted->stats();
+
+    REQUIRE(sender.has_value());
+    REQUIRE(receiver.has_value());
+    REQUIRE(sender->bytes_sent == 7 * sent);
+    REQUIRE(receiver->bytes_received == 7 * sent);
+    REQUIRE(receiver->receive_queue == 0);
+
+    auto pair = socket_t::pair();
+
+    REQUIRE(pair.has_value());
+
+    auto missing = pair->first.stats();
+
+    REQUIRE(!missing.has_value());
+}
+
+TEST_CASE("Spin-then-block receive")
+{
+    using namespace std::chrono_literals;
+
+    auto sockets = socket_t::pair();
+    REQUIRE(sockets.has_value());
+
+    auto& [left, right] = *sockets;
+    std::array<char, 8> buffer{};
+
+    REQUIRE(right.set_busy_poll(50us).has_value());
+    REQUIRE(bytes(left.send(std::string_view("hot"))) == 3);
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size(), busy_poll_t{10us})) == 3);
+
+    auto expired = right.recv(buffer.data(), buffer.size(), busy_poll_t{10us, 5});
+
+    REQUIRE(!expired.has_value());
+    REQUIRE(expired.error() == std::errc::timed_out);
+
+    std::jthread sender([&left = left] {
+        std::this_thread::sleep_for(5ms);
+        std::ignore = left.send(std::string_view("late"));
+    });
+
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size(), busy_poll_t{1us})) == 4);
+
+    // Signals arriving faster than the timeout must not keep extending it.
+    struct sigaction action{};
+    struct sigaction previous{};
+    action.sa_handler = [](int /* signal */) {};
+    REQUIRE(::sigaction(SIGUSR1, &action, &previous) == 0);
+
+    std::atomic<bool> waiting{true};
+    pthread_t receiver = ::pthread_self();
+
+    std::jthread interrupter([&waiting, receiver] {
+        while (waiting.load())
+        {
+            ::pthread_kill(receiver, SIGUSR1);
+            std::this_thread::sleep_for(10ms);
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    auto interrupted = right.recv(buffer.data(), buffer.size(), busy_poll_t{1us, 50});
+
+    waiting.store(false);
+    interrupter.join();
+    ::sigaction(SIGUSR1, &previous, nullptr);
+
+    REQUIRE(interrupted.error() == std::errc::timed_out);
+    REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+}
+
+TEST_CASE("Paced send")
+{
+    using namespace std::chrono_literals;
+
+    auto sockets = socket_t::pair();
+    REQUIRE(sockets.has_value());
+
+    auto& [left, right] = *sockets;
+    std::array<char, 64> buffer{};
+
+    token_bucket_t<> pacer(1000.0, 16);
+
+    REQUIRE(bytes(left.send(std::string_view("0123456789abcdefXYZ"), pacer)) == 16);
+    REQUIRE(pacer.available() < 16);
+
+    auto start = std::chrono::steady_clock::now();
+
+    REQUIRE(bytes(left.send(std::string_view("XYZ"), pacer)) >= 1);
+    REQUIRE(std::chrono::steady_clock::now() - start >= 500us);
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size())) >= 17);
+
+    right.close();
+
+    auto failed = left.send(std::string_view("lost"), pacer);
+
+    REQUIRE(!failed.has_value());
+    REQUIRE(failed.error() == std::errc::broken_pipe);
+    REQUIRE(pacer.available() >= 1);
+}
+
+TEST_CASE("Cancellable socket operations")
+{
+    using namespace std::chrono_literals;
+
+    auto sockets = socket_t::pair();
+    REQUIRE(sockets.has_value());
+
+    auto& [left, right] = *sockets;
+    std::array<char, 8> buffer{};
+
+    REQUIRE(bytes(left.send(std::string_view("ready"), cancel_token_t::after(1s))) == 5);
+    REQUIRE(bytes(right.recv(buffer.data(), buffer.size(), cancel_token_t::after(1s))) == 5);
+
+    auto start = std::chrono::steady_clock::now();
+    auto idle = right.recv(buffer.data(), buffer.size(), cancel_token_t::after(20ms));
+
+    REQUIRE(!idle.has_value());
+    REQUIRE(idle.error() == std::errc::timed_out);
+    REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+
+    cancel_source_t shutdown;
+
+    std::jthread canceller([&shutdown] {
+        std::this_thread::sleep_for(10ms);
+        shutdown.cancel();
+    });
+
+    auto stuck = right.recv(buffer.data(), buffer.size(), shutdown.token(10s));
+
+    REQUIRE(!stuck.has_value());
+    REQUIRE(stuck.error() == std::errc::operation_canceled);
+    REQUIRE(std::chrono::steady_clock::now() - start < 5s);
+
+    auto address = endpoint_t::ipv4(INADDR_LOOPBACK, 0);
+    socket_t server(address);
+
+    REQUIRE(server.bind(address).has_value());
+    REQUIRE(server.listen().has_value());
+
+    auto bound = server.local_endpoint();
+
+    REQUIRE(bound.has_value());
+
+    address = *bound;
+
+    REQUIRE(server.accept(cancel_token_t::after(10ms)).error() == std::errc::invalid_argument);
+    REQUIRE(server.set_nonblocking().has_value());
+
+    auto nobody = server.accept(cancel_token_t::after(10ms));
+
+    REQUIRE(!nobody.has_value());
+    REQUIRE(nobody.error() == std::errc::timed_out);
+
+    socket_t client(address);
+
+    REQUIRE(client.connect(address, cancel_token_t::after(1s)).has_value());
+    REQUIRE(server.accept(cancel_token_t::after(1s)).has_value());
+    REQUIRE(!server.accept(shutdown.token()).has_value());
+
+    // Two acceptors race for one connection; the loser times out instead of
+    // blocking in accept4.
+    {
+        std::atomic<int> accepted{0};
+        std::atomic<int> timed_out{0};
+
+        {
+            std::vector<std::jthread> acceptors;
+
+            for (int i = 0; i < 2; ++i)
+            {
+                acceptors.emplace_back([&server, &accepted, &timed_out] {
+                    auto connection = server.accept(cancel_token_t::after(200ms));
+
+                    if (connection.has_value())
+                    {
+                        accepted.fetch_add(1);
+                    }
+                    else if (connection.error() == std::errc::timed_out)
+                    {
+                        timed_out.fetch_add(1);
+                    }
+                });
+            }
+
+            socket_t racer(address);
+            REQUIRE(racer.connect(address, cancel_token_t::after(1s)).has_value());
+        }
+
+        REQUIRE(accepted.load() == 1);
+        REQUIRE(timed_out.load() == 1);
+    }
+
+    socket_t refused(address);
+    auto closed = refused.connect(endpoint_t::ipv4(INADDR_LOOPBACK, 1), cancel_token_t::after(1s));
+
+    REQUIRE(!closed.has_value());
+    REQUIRE(closed.error() == std::errc::connection_refused);
+}
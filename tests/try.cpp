@@ -0,0 +1,145 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "try.hpp"
+
+/// \cond
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+namespace
+{
+
+struct Payload
+{
+    static inline std::size_t copies = 0;
+    static inline std::size_t moves = 0;
+
+    explicit Payload(int number)
+        : value(number)
+    {}
+
+    Payload(const Payload& that)
+        : value(that.value)
+    {
+        copies += 1;
+    }
+
+    Payload(Payload&& that) noexcept
+        : value(that.value)
+    {
+        moves += 1;
+    }
+
+    ~Payload() = default;
+
+    Payload& operator=(const Payload&) = delete;
+    Payload& operator=(Payload&&) = delete;
+
+    int value;
+};
+
+}  // namespace
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static result_t<Payload, std::string> parse(int number)
+{
+    if (number < 0)
+    {
+        return fail_t<std::string>("negative");
+    }
+
+    return success_t<Payload>(number);
+}
+
+static result_t<int, std::string> twice(int number)
+{
+    auto payload = TRY(parse(number));
+    return success_t<int>(payload.value * 2);
+}
+
+static result_t<int, std::string> quadruple(int number)
+{
+    return success_t<int>(TRY(twice(TRY(twice(number)))));
+}
+
+static maybe_t<int> half(maybe_t<int> number)
+{
+    int value = TRY(std::move(number));
+    return value / 2;
+}
+
+static result_t<int, std::string> coro_twice(int number)
+{
+    auto payload = co_await parse(number);
+    co_return payload.value * 2;
+}
+
+static result_t<void, std::string> coro_check(int number)
+{
+    if (number > 100)
+    {
+        co_await fail_t<std::string>("too large");
+    }
+
+    co_await parse(number);
+}
+
+static maybe_t<int> coro_half(maybe_t<int> number)
+{
+    int value = co_await std::move(number);
+    co_return value / 2;
+}
+
+static result_t<int, std::string> coro_hold(const std::shared_ptr<int>& held, int number)
+{
+    std::shared_ptr<int> copy = held;
+    auto payload = co_await parse(number);
+    co_return *copy + payload.value;
+}
+
+TEST_CASE("Propagate with TRY")
+{
+    REQUIRE(*twice(21) == 42);
+    REQUIRE(twice(-1).error() == "negative");
+    REQUIRE(*quadruple(5) == 20);
+    REQUIRE(quadruple(-1).error() == "negative");
+
+    REQUIRE(*half(8) == 4);
+    REQUIRE(!half(utils::nothing).has_value());
+
+    Payload::copies = 0;
+    Payload::moves = 0;
+
+    REQUIRE(*twice(1) == 2);
+    REQUIRE(Payload::copies == 0);
+}
+
+TEST_CASE("Propagate with co_await")
+{
+    REQUIRE(*coro_twice(21) == 42);
+    REQUIRE(coro_twice(-1).error() == "negative");
+
+    REQUIRE(coro_check(5).has_value());
+    REQUIRE(coro_check(-5).error() == "negative");
+    REQUIRE(coro_check(500).error() == "too large");
+
+    REQUIRE(*coro_half(8) == 4);
+    REQUIRE(!coro_half(utils::nothing).has_value());
+
+    auto held = std::make_shared<int>(7);
+
+    REQUIRE(*coro_hold(held, 1) == 8);
+    REQUIRE(coro_hold(held, -1).error() == "negative");
+    REQUIRE(held.use_count() == 1);
+}
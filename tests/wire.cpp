@@ -0,0 +1,215 @@
+/*****************************************************************************/
+/*** HEADER INCLUDES *********************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "wire.hpp"
+
+/// \cond
+#include <sys/mman.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \endcond
+
+/*****************************************************************************/
+/*** DATA TYPES **************************************************************/
+
+namespace
+{
+
+enum class side_t : std::uint8_t
+{
+    buy,
+    sell
+};
+
+struct level_t
+{
+    double price;
+    std::uint32_t quantity;
+};
+
+struct note_t
+{
+    std::string_view text;
+};
+
+struct order_t
+{
+    std::uint64_t id;
+    side_t side;
+    std::string symbol;
+    maybe_t<double> limit;
+    maybe_t<std::string> client;
+    result_t<level_t, std::string> fill;
+    result_t<void, int> ack;
+    level_t best;
+    bool urgent;
+};
+
+}  // namespace
+
+/*****************************************************************************/
+/*** TEST CASES **************************************************************/
+
+static_assert(wire::field_count_v<level_t> == 2);
+static_assert(wire::field_count_v<order_t> == 9);
+static_assert(wire::flag_bytes<order_t> == 1);
+static_assert(wire::flag_bytes<level_t> == 0);
+
+TEST_CASE("Wire encoding round trips records")
+{
+    order_t order{42, side_t::sell, "ACME", 10.5, utils::nothing, success_t<level_t>(level_t{10.25, 300}), {}, {10.0, 5}, true};
+
+    std::size_t expected = 1 + 8 + 1 + (4 + 4) + 8 + (8 + 4) + (8 + 4) + 1;
+    REQUIRE(encoded_size(order) == expected);
+
+    std::vector<std::byte> buffer(encoded_size(order));
+    auto written = encode(order, buffer);
+
+    REQUIRE(written.has_value());
+    REQUIRE(*written == expected);
+
+    auto view = wire_view_t<order_t>::parse(buffer);
+
+    REQUIRE(view.has_value());
+    REQUIRE(view->size() == expected);
+
+    REQUIRE(view->get<0>() == 42);
+    REQUIRE(view->get<1>() == side_t::sell);
+    REQUIRE(view->get<2>() == "ACME");
+    REQUIRE(view->get<2>().data() == reinterpret_cast<const char*>(buffer.data() + 14));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    REQUIRE(*view->get<3>() == 10.5);
+    REQUIRE(!view->get<4>().has_value());
+
+    auto fill = view->get<5>();
+    REQUIRE(fill.has_value());
+    REQUIRE(fill->get<0>() == 10.25);
+    REQUIRE(fill->get<1>() == 300);
+
+    REQUIRE(view->get<6>().has_value());
+    REQUIRE(view->get<7>().get<1>() == 5);
+    REQUIRE(view->get<8>());
+
+    auto copy = view->materialize();
+
+    REQUIRE(copy.id == 42);
+    REQUIRE(copy.symbol == "ACME");
+    REQUIRE(*copy.limit == 10.5);
+    REQUIRE(!copy.client.has_value());
+    REQUIRE(copy.fill.has_value());
+    REQUIRE(copy.fill->quantity == 300);
+    REQUIRE(copy.ack.has_value());
+    REQUIRE(copy.best.price == 10.0);
+    REQUIRE(copy.urgent);
+}
+
+TEST_CASE("Wire encoding carries errors and empty fields")
+{
+    order_t order{7, side_t::buy, "", utils::nothing, std::string("desk-4"), fail_t<std::string>("rejected"), fail_t<int>(-3), {}, false};
+
+    std::vector<std::byte> buffer(encoded_size(order));
+    REQUIRE(encode(order, buffer).has_value());
+
+    REQUIRE(std::to_integer<unsigned>(buffer[0]) == 0b0010);
+
+    auto view = wire_view_t<order_t>::parse(buffer);
+    REQUIRE(view.has_value());
+
+    REQUIRE(view->get<2>().empty());
+    REQUIRE(!view->get<3>().has_value());
+    REQUIRE(*view->get<4>() == "desk-4");
+
+    auto fill = view->get<5>();
+    REQUIRE(!fill.has_value());
+    REQUIRE(fill.error() == "rejected");
+
+    auto ack = view->get<6>();
+    REQUIRE(!ack.has_value());
+    REQUIRE(ack.error() == -3);
+
+    auto copy = view->materialize();
+
+    REQUIRE(*copy.client == "desk-4");
+    REQUIRE(copy.fill.error() == "rejected");
+    REQUIRE(copy.ack.error() == -3);
+}
+
+TEST_CASE("Wire decoding rejects bad input")
+{
+    order_t order{1, side_t::buy, "ACME", 1.0, std::string("desk"), fail_t<std::string>("no"), {}, {}, false};
+
+    std::vector<std::byte> buffer(encoded_size(order));
+
+    SECTION("Short output buffer")
+    {
+        std::array<std::byte, 8> small{};
+        auto written = encode(order, small);
+
+        REQUIRE(!written.has_value());
+        REQUIRE(written.error() == wire_error_t::buffer_too_small);
+    }
+
+    REQUIRE(encode(order, buffer).has_value());
+
+    SECTION("Every truncation")
+    {
+        for (std::size_t length = 0; length < buffer.size(); ++length)
+        {
+            auto view = wire_view_t<order_t>::parse(std::span<const std::byte>(buffer.data(), length));
+
+            REQUIRE(!view.has_value());
+            REQUIRE(view.error() == wire_error_t::truncated);
+        }
+    }
+
+    SECTION("Oversized string length")
+    {
+        buffer[10] = std::byte{0xff};
+
+        REQUIRE(!wire_view_t<order_t>::parse(buffer).has_value());
+    }
+
+    SECTION("Unknown presence bits")
+    {
+        buffer[0] |= std::byte{0x10};
+
+        auto view = wire_view_t<order_t>::parse(buffer);
+
+        REQUIRE(!view.has_value());
+        REQUIRE(view.error() == wire_error_t::malformed);
+    }
+
+    SECTION("Trailing bytes belong to the next message")
+    {
+        buffer.push_back(std::byte{0x55});
+
+        auto view = wire_view_t<order_t>::parse(buffer);
+
+        REQUIRE(view.has_value());
+        REQUIRE(view->size() == buffer.size() - 1);
+    }
+}
+
+TEST_CASE("Wire encoding rejects records past the 32-bit lengths")
+{
+    // Address space only: encode() must refuse before reading any of it.
+    std::size_t size = std::size_t{std::numeric_limits<wire::length_type>::max()} + 1;
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    REQUIRE(address != MAP_FAILED);
+
+    note_t note{std::string_view(static_cast<const char*>(address), size)};
+
+    REQUIRE(encode(note, std::span<std::byte>()).error() == wire_error_t::too_large);
+    REQUIRE(encode(note_t{"short"}, std::span<std::byte>()).error() == wire_error_t::buffer_too_small);
+
+    ::munmap(address, size);
+}